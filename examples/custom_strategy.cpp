@@ -1,29 +1,43 @@
 #include "data_loader/args_parses.hpp"
 #include "data_loader/csv_parser.hpp"
+#include "data_loader/mmap_csv_parser.hpp"
 #include "execution/backtesing_engine.hpp"
 #include "metrics/metrics_calculator.hpp"
 #include "types.hpp"
+#include "vaults/indicators.hpp"
 #include "vaults/portfolio.hpp"
+#include <algorithm>
 #include <memory>
-#include <numeric>
+#include <span>
 
 namespace vault {
 
 class SMACrossoverStrategy : public StrategyBase {
 private:
   vault::Portfolio::SPtr portfolio_;
-  size_t fast_window_{3};
-  size_t slow_window_{7};
-  std::vector<double> fast_prices_;
-  std::vector<double> slow_prices_;
+  indicators::SMA fast_sma_{3};
+  indicators::SMA slow_sma_{7};
   int position_{0}; // -1 = short, 0 = flat, 1 = long
   double risk_per_trade_{0.01};
   size_t tick_count_{0};
+  // Amount bought and not sold yet, kept up to date from the fills.
+  common_types::Amount open_amount_{};
 
 public:
   explicit SMACrossoverStrategy(const vault::Portfolio::SPtr &portfolio)
       : portfolio_(portfolio) {}
 
+  void on_fill(const common_types::Order &order,
+               std::span<const common_types::ExecutionFill> fills) override {
+    for (const auto &fill : fills) {
+      if (order.side == common_types::Side::Buy) {
+        open_amount_ += fill.amount;
+      } else {
+        open_amount_ -= std::min(open_amount_, fill.amount);
+      }
+    }
+  }
+
   std::optional<common_types::Order> on_tick() override {
     tick_count_++;
     const double mid = mid_price();
@@ -31,25 +45,15 @@ public:
       return std::nullopt;
     }
 
-    fast_prices_.push_back(mid);
-    slow_prices_.push_back(mid);
-
-    if (fast_prices_.size() > fast_window_)
-      fast_prices_.erase(fast_prices_.begin());
-    if (slow_prices_.size() > slow_window_)
-      slow_prices_.erase(slow_prices_.begin());
+    fast_sma_.update(mid);
+    slow_sma_.update(mid);
 
-    if (fast_prices_.size() < fast_window_ ||
-        slow_prices_.size() < slow_window_) {
+    if (!fast_sma_.ready() || !slow_sma_.ready()) {
       return std::nullopt;
     }
 
-    double fast_sma =
-        std::accumulate(fast_prices_.begin(), fast_prices_.end(), 0.0) /
-        fast_prices_.size();
-    double slow_sma =
-        std::accumulate(slow_prices_.begin(), slow_prices_.end(), 0.0) /
-        slow_prices_.size();
+    const double fast_sma = fast_sma_.value();
+    const double slow_sma = slow_sma_.value();
 
     double cash_to_use = portfolio_->get_cash_amount() * risk_per_trade_;
     double amount_to_trade = cash_to_use / best_ask();
@@ -72,7 +76,7 @@ public:
       }
     }
 
-    if (!portfolio_->get_all_positions().empty()) {
+    if (open_amount_ > common_types::Amount{}) {
       portfolio_->update_portfolio_value(mid);
     }
 
@@ -85,9 +89,14 @@ public:
 int main(int argc, char *argv[]) {
   ProgramArgs args = parse_arguments(argc, argv);
 
-  data_loading::CSVParser csv_parser;
+  auto csv_parser =
+      args.parser == "mmap"
+          ? data_loading::create_parser<data_loading::MMapCSVParser>(
+                25, args.threads)
+          : data_loading::create_parser<data_loading::CSVParser>();
+  csv_parser->set_scale(args.scale);
 
-  auto lob_data = csv_parser.parse_lob(args.lob);
+  auto lob_data = csv_parser->parse_lob(args.lob);
 
   auto portfolio = vault::Portfolio::create_portfolio();
   portfolio->set_amount(10000);
@@ -99,6 +108,7 @@ int main(int argc, char *argv[]) {
 
   execution::BacktestEngine eng;
   eng.link_portfolio(portfolio);
+  eng.set_instrument_scale(args.scale);
   eng.add_data(lob_data);
   eng.set_strategy(std::move(strat));
 
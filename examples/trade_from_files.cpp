@@ -1,5 +1,6 @@
 #include "data_loader/args_parses.hpp"
 #include "data_loader/csv_parser.hpp"
+#include "data_loader/mmap_csv_parser.hpp"
 #include "execution/backtesing_engine.hpp"
 #include "metrics/metrics_calculator.hpp"
 #include "vaults/portfolio.hpp"
@@ -10,10 +11,14 @@
 int main(int argc, char *argv[]) {
   ProgramArgs args = parse_arguments(argc, argv);
 
-  data_loading::CSVParser csv_parser;
+  auto csv_parser =
+      args.parser == "mmap"
+          ? data_loading::create_parser<data_loading::MMapCSVParser>(
+                25, args.threads)
+          : data_loading::create_parser<data_loading::CSVParser>();
+  csv_parser->set_scale(args.scale);
 
-  auto lob_data = csv_parser.parse_lob(args.lob);
-  auto trades_data = csv_parser.parse_trades(args.trades);
+  auto [lob_data, trades_data] = csv_parser->load(args.lob, args.trades);
 
   auto portfolio = vault::Portfolio::create_portfolio();
   portfolio->set_amount(0);
@@ -24,6 +29,7 @@ int main(int argc, char *argv[]) {
 
   execution::BacktestEngine eng;
   eng.link_portfolio(portfolio);
+  eng.set_instrument_scale(args.scale);
   eng.add_data(lob_data);
   eng.set_strategy(std::move(strat));
 
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "types.hpp"
+#include <cstddef>
 #include <iostream>
 #include <string>
 
@@ -11,6 +13,12 @@ struct ProgramArgs {
   std::string lob;
   /// Path to the trades csv file (optional).
   std::string trades;
+  /// Parser backend: "csv" (default) or "mmap".
+  std::string parser{"csv"};
+  /// Number of parser threads for the mmap backend; 0 means one per core.
+  std::size_t threads{1};
+  /// Fixed-point scale of prices and amounts (used with HFT_TASK_FIXED_POINT).
+  common_types::InstrumentScale scale;
 };
 
 /**
@@ -19,13 +27,27 @@ struct ProgramArgs {
  * @param program_name Name of the executable (usually argv[0]).
  */
 inline void print_usage(const std::string &program_name) {
-  std::cout << "Usage: " << program_name << " --lob <value> [--trades <value>]"
+  std::cout << "Usage: " << program_name
+            << " --lob <value> [--trades <value>] [--parser <csv|mmap>]"
+               " [--threads <value>] [--price-decimals <value>]"
+               " [--amount-decimals <value>]"
             << std::endl;
   std::cout << "Options:" << std::endl;
   std::cout << "  --lob <value>     Specify path to lob.csv (mandatory)"
             << std::endl;
   std::cout << "  --trades <value>  Specify path to trades.csv (optional)"
             << std::endl;
+  std::cout << "  --parser <value>  Parser backend: csv or mmap (optional)"
+            << std::endl;
+  std::cout << "  --threads <value> Parser threads for mmap, 0 = all cores "
+               "(optional)"
+            << std::endl;
+  std::cout << "  --price-decimals <value>  Decimal places of a price tick "
+               "in the fixed-point build (optional)"
+            << std::endl;
+  std::cout << "  --amount-decimals <value> Decimal places of an amount lot "
+               "in the fixed-point build (optional)"
+            << std::endl;
   std::cout << "  --help            Show this help message" << std::endl;
 }
 
@@ -35,6 +57,10 @@ inline void print_usage(const std::string &program_name) {
  * Supported arguments:
  * - --lob <value>      : Path to the LOB CSV file (mandatory).
  * - --trades <value>   : Path to the trades CSV file (optional).
+ * - --parser <value>   : Parser backend, "csv" or "mmap" (optional).
+ * - --threads <value>  : Parser threads for the mmap backend (optional).
+ * - --price-decimals <value>  : Decimal places of a price tick (optional).
+ * - --amount-decimals <value> : Decimal places of an amount lot (optional).
  * - --help             : Prints usage instructions and exits.
  *
  * @param argc Number of command-line arguments.
@@ -62,6 +88,35 @@ inline ProgramArgs parse_arguments(int argc, char *argv[]) {
       } else {
         throw std::runtime_error("--trades requires a value");
       }
+    } else if (arg == "--parser") {
+      if (i + 1 < argc) {
+        args.parser = argv[++i];
+      } else {
+        throw std::runtime_error("--parser requires a value");
+      }
+      if (args.parser != "csv" && args.parser != "mmap") {
+        throw std::runtime_error("Unknown parser: " + args.parser);
+      }
+    } else if (arg == "--threads") {
+      if (i + 1 < argc) {
+        args.threads = std::stoul(argv[++i]);
+      } else {
+        throw std::runtime_error("--threads requires a value");
+      }
+    } else if (arg == "--price-decimals") {
+      if (i + 1 < argc) {
+        args.scale = common_types::InstrumentScale(
+            std::stoi(argv[++i]), args.scale.amount_decimals());
+      } else {
+        throw std::runtime_error("--price-decimals requires a value");
+      }
+    } else if (arg == "--amount-decimals") {
+      if (i + 1 < argc) {
+        args.scale = common_types::InstrumentScale(args.scale.price_decimals(),
+                                                   std::stoi(argv[++i]));
+      } else {
+        throw std::runtime_error("--amount-decimals requires a value");
+      }
     } else if (arg == "--help") {
       print_usage(argv[0]);
       exit(0);
@@ -0,0 +1,197 @@
+#pragma once
+
+#include "data_loader/mapped_file.hpp"
+#include "types.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace data_loading {
+
+/**
+ * @brief Compact columnar on-disk format for LOB snapshots and trades.
+ *
+ * A file starts with a FileHeader followed by column arrays stored in native
+ * byte order. LOB files (depth D, N rows):
+ *   int64  timestamps[N]
+ *   uint32 ask_counts[N], bid_counts[N]
+ *   Price  ask_prices[N * D], Amount ask_amounts[N * D]
+ *   Price  bid_prices[N * D], Amount bid_amounts[N * D]
+ * Levels of row i occupy [i * D, i * D + count) and the rest is zero padded.
+ * Trades files (N rows):
+ *   int64 timestamps[N]
+ *   Price prices[N], Amount amounts[N]
+ *   int8 sides[N]
+ * Price and Amount are doubles, or int64 ticks and lots in the fixed-point
+ * build (FLAG_FIXED_POINT set, the scale is kept in the header).
+ */
+namespace binary {
+
+/// Magic number of LOB snapshot files ("HLOB").
+constexpr std::uint32_t LOB_MAGIC = 0x424F4C48;
+/// Magic number of trades files ("HTRD").
+constexpr std::uint32_t TRADES_MAGIC = 0x44525448;
+/// Current format version.
+constexpr std::uint32_t FORMAT_VERSION = 1;
+/// Header flag: prices and amounts are stored as fixed-point integers.
+constexpr std::uint64_t FLAG_FIXED_POINT = 1;
+
+/// @brief Header at the beginning of every binary market data file.
+struct FileHeader {
+  std::uint32_t magic{0};           ///< LOB_MAGIC or TRADES_MAGIC.
+  std::uint32_t version{0};         ///< FORMAT_VERSION.
+  std::uint32_t depth{0};           ///< Levels per side (0 for trades).
+  std::uint16_t price_decimals{0};  ///< Scale of fixed-point prices.
+  std::uint16_t amount_decimals{0}; ///< Scale of fixed-point amounts.
+  std::uint64_t rows{0};            ///< Number of snapshots or trades.
+  std::uint64_t flags{0};           ///< FLAG_* bits.
+};
+
+static_assert(sizeof(FileHeader) == 32, "FileHeader must stay 32 bytes");
+
+/**
+ * @brief Writes LOB snapshots to a binary columnar file.
+ *
+ * @param filename Output path.
+ * @param lob_data Snapshots to store.
+ * @param scale Scale the snapshots were loaded with.
+ *
+ * @throws std::runtime_error If the file cannot be written.
+ */
+void write_lob(const std::string &filename,
+               const std::vector<raw_data::LOBData> &lob_data,
+               const common_types::InstrumentScale &scale = {});
+
+/**
+ * @brief Writes trades to a binary columnar file.
+ *
+ * @param filename Output path.
+ * @param trades Trades to store.
+ * @param scale Scale the trades were loaded with.
+ *
+ * @throws std::runtime_error If the file cannot be written.
+ */
+void write_trades(const std::string &filename,
+                  const std::vector<raw_data::TradeData> &trades,
+                  const common_types::InstrumentScale &scale = {});
+
+/**
+ * @brief Checks whether a file starts with the given binary magic number.
+ *
+ * @param filename Path to the file.
+ * @param magic LOB_MAGIC or TRADES_MAGIC.
+ * @return true If the file exists and carries the magic number.
+ */
+bool has_magic(const std::string &filename, std::uint32_t magic);
+
+} // namespace binary
+
+/**
+ * @brief Memory-mapped read-only view of a binary LOB file.
+ *
+ * Columns are accessed directly in the mapping; nothing is parsed on load.
+ */
+class BinaryLOBFile {
+public:
+  /**
+   * @brief Maps and validates a binary LOB file.
+   *
+   * @param filename Path to the file written by binary::write_lob.
+   *
+   * @throws std::runtime_error If the file is missing, truncated or of a
+   * different format.
+   */
+  explicit BinaryLOBFile(const std::string &filename);
+
+  /** @brief Returns number of snapshots. */
+  inline std::size_t size() const noexcept { return rows_; }
+
+  /** @brief Returns the scale the snapshots were stored with. */
+  inline const common_types::InstrumentScale &scale() const noexcept {
+    return scale_;
+  }
+
+  /** @brief Returns number of level slots per side. */
+  inline std::size_t depth() const noexcept { return depth_; }
+
+  /** @brief Returns timestamp of the i-th snapshot. */
+  inline long long timestamp(std::size_t i) const noexcept {
+    return timestamps_[i];
+  }
+
+  /** @brief Returns the timestamp column. */
+  inline const std::int64_t *timestamps() const noexcept {
+    return timestamps_;
+  }
+
+  /**
+   * @brief Copies the i-th snapshot into a caller-owned LOBData.
+   *
+   * The output vectors are reused, so calling this in a loop with the same
+   * object does not allocate after the first snapshot.
+   *
+   * @param i Snapshot index.
+   * @param out Destination snapshot.
+   */
+  void load(std::size_t i, raw_data::LOBData &out) const;
+
+private:
+  MappedFile file_;                                  ///< Mapping of the file.
+  std::size_t rows_{0};                              ///< Number of snapshots.
+  std::size_t depth_{0};                             ///< Level slots per side.
+  common_types::InstrumentScale scale_;              ///< Stored scale.
+  const std::int64_t *timestamps_{nullptr};          ///< Timestamp column.
+  const std::uint32_t *ask_counts_{nullptr};         ///< Ask levels per row.
+  const std::uint32_t *bid_counts_{nullptr};         ///< Bid levels per row.
+  const common_types::Price *ask_prices_{nullptr};   ///< Ask price column.
+  const common_types::Amount *ask_amounts_{nullptr}; ///< Ask amount column.
+  const common_types::Price *bid_prices_{nullptr};   ///< Bid price column.
+  const common_types::Amount *bid_amounts_{nullptr}; ///< Bid amount column.
+};
+
+/**
+ * @brief Memory-mapped read-only view of a binary trades file.
+ */
+class BinaryTradesFile {
+public:
+  /**
+   * @brief Maps and validates a binary trades file.
+   *
+   * @param filename Path to the file written by binary::write_trades.
+   *
+   * @throws std::runtime_error If the file is missing, truncated or of a
+   * different format.
+   */
+  explicit BinaryTradesFile(const std::string &filename);
+
+  /** @brief Returns number of trades. */
+  inline std::size_t size() const noexcept { return rows_; }
+
+  /** @brief Returns the scale the trades were stored with. */
+  inline const common_types::InstrumentScale &scale() const noexcept {
+    return scale_;
+  }
+
+  /** @brief Returns the timestamp column. */
+  inline const std::int64_t *timestamps() const noexcept {
+    return timestamps_;
+  }
+
+  /** @brief Returns the i-th trade. */
+  raw_data::TradeData trade(std::size_t i) const noexcept;
+
+  /** @brief Copies all trades into a vector. */
+  std::vector<raw_data::TradeData> to_vector() const;
+
+private:
+  MappedFile file_;                              ///< Mapping of the file.
+  std::size_t rows_{0};                          ///< Number of trades.
+  common_types::InstrumentScale scale_;          ///< Stored scale.
+  const std::int64_t *timestamps_{nullptr};      ///< Timestamp column.
+  const common_types::Price *prices_{nullptr};   ///< Price column.
+  const common_types::Amount *amounts_{nullptr}; ///< Amount column.
+  const std::int8_t *sides_{nullptr};            ///< Side column.
+};
+
+} // namespace data_loading
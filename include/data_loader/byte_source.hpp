@@ -0,0 +1,169 @@
+#pragma once
+
+#include "utils/spsc_ring.hpp"
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <fstream>
+#include <memory>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace data_loading {
+
+/**
+ * @brief Abstract sequential source of raw bytes.
+ *
+ * Hides whether the input file is plain or compressed from the line readers
+ * and parsers built on top of it.
+ */
+class ByteSourceAbstract {
+public:
+  /// Unique pointer alias for convenience.
+  using UPtr = std::unique_ptr<ByteSourceAbstract>;
+
+  /// Virtual destructor for proper cleanup in derived classes.
+  virtual ~ByteSourceAbstract() = default;
+
+  /**
+   * @brief Reads up to `size` bytes.
+   *
+   * @param dst Destination buffer.
+   * @param size Capacity of the destination buffer.
+   * @return std::size_t Number of bytes read, 0 at end of input.
+   */
+  virtual std::size_t read(char *dst, std::size_t size) = 0;
+
+  /**
+   * @brief Repositions the source at an absolute byte offset.
+   *
+   * @param offset Offset from the beginning of the (uncompressed) input.
+   * @return true If the source moved to `offset`.
+   * @return false If the source cannot seek; it is left untouched.
+   */
+  virtual bool seek(std::size_t /*offset*/) { return false; }
+};
+
+/**
+ * @brief Byte source over an uncompressed file.
+ */
+class FileByteSource final : public ByteSourceAbstract {
+public:
+  /**
+   * @brief Opens the file.
+   *
+   * @param filename Path to the file.
+   *
+   * @throws std::runtime_error If the file cannot be opened.
+   */
+  explicit FileByteSource(const std::string &filename);
+
+  std::size_t read(char *dst, std::size_t size) override;
+
+  bool seek(std::size_t offset) override;
+
+private:
+  std::ifstream file_; ///< Underlying file stream.
+};
+
+/**
+ * @brief Byte source decompressing a gzip file on a background thread.
+ *
+ * The decompression thread fills fixed-size blocks of a bounded SPSC ring
+ * while the reader consumes them, so inflating overlaps with parsing and
+ * the uncompressed data never touches the disk.
+ */
+class GzipByteSource final : public ByteSourceAbstract {
+public:
+  /// Size of one decompressed block in bytes.
+  static constexpr std::size_t BLOCK_SIZE = 1 << 18;
+  /// Number of decompressed blocks buffered ahead.
+  static constexpr std::size_t BLOCK_COUNT = 8;
+
+  /**
+   * @brief Opens the file and starts the decompression thread.
+   *
+   * @param filename Path to the gzip file.
+   *
+   * @throws std::runtime_error If the file cannot be opened or the library
+   * was built without zlib.
+   */
+  explicit GzipByteSource(const std::string &filename);
+
+  /// Stops and joins the decompression thread.
+  ~GzipByteSource() override;
+
+  GzipByteSource(const GzipByteSource &) = delete;
+  GzipByteSource &operator=(const GzipByteSource &) = delete;
+
+  /**
+   * @brief Reads decompressed bytes, waiting for the inflating thread.
+   *
+   * @throws std::runtime_error If the compressed stream is corrupted.
+   */
+  std::size_t read(char *dst, std::size_t size) override;
+
+private:
+  /// @brief Decompressed block handed from the inflating thread.
+  struct Block {
+    std::vector<char> data; ///< Block storage of BLOCK_SIZE bytes.
+    std::size_t size{0};    ///< Number of valid bytes.
+  };
+
+  /// Decompression loop run on inflater_.
+  void inflate(void *gz_file);
+
+private:
+  utils::SPSCRing<Block> ring_{BLOCK_COUNT}; ///< Decompressed blocks.
+  std::atomic<bool> done_{false};            ///< Inflater reached end of input.
+  std::atomic<bool> stop_{false};            ///< Reader asks inflater to exit.
+  std::exception_ptr error_; ///< Exception thrown by the inflater.
+  Block *current_{nullptr};  ///< Block being consumed by read().
+  std::size_t offset_{0};    ///< Read offset inside current_.
+  std::thread inflater_;     ///< Background decompression thread.
+};
+
+/**
+ * @brief std::streambuf adapter so std::istream code can read a byte source.
+ */
+class ByteSourceStreamBuf final : public std::streambuf {
+public:
+  /**
+   * @brief Wraps a byte source.
+   *
+   * @param source Source to read from; owned by the buffer.
+   * @param buffer_size Size of the get area in bytes.
+   */
+  explicit ByteSourceStreamBuf(ByteSourceAbstract::UPtr &&source,
+                               std::size_t buffer_size = 1 << 16);
+
+protected:
+  int_type underflow() override;
+
+private:
+  ByteSourceAbstract::UPtr source_; ///< Wrapped byte source.
+  std::vector<char> buffer_;        ///< Get area.
+};
+
+/**
+ * @brief Checks whether a file starts with the gzip magic bytes.
+ *
+ * @param filename Path to the file.
+ * @return true If the file is gzip compressed.
+ */
+bool is_gzip_file(const std::string &filename);
+
+/**
+ * @brief Opens a file as a byte source, detecting gzip compression.
+ *
+ * @param filename Path to a plain or gzip compressed file.
+ * @return ByteSourceAbstract::UPtr GzipByteSource for compressed input,
+ * FileByteSource otherwise.
+ *
+ * @throws std::runtime_error If the file cannot be opened.
+ */
+ByteSourceAbstract::UPtr open_byte_source(const std::string &filename);
+
+} // namespace data_loading
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "data_loader/line_parsers.hpp"
+#include "data_loader/line_reader.hpp"
+#include "data_loader/timestamp_index.hpp"
+#include "logging.hpp"
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <string_view>
+
+namespace data_loading {
+
+/**
+ * @brief Forward cursor over the rows of a timestamped CSV file.
+ *
+ * Shared by the streaming snapshot and trade sources. Rows are read through
+ * a bounded LineReader. If a TimestampIndex built from the file is found
+ * next to it (`<file>.idx`), seek() jumps straight to the indexed row;
+ * otherwise it scans timestamps only.
+ *
+ * Rows are parsed by the caller's `parse(std::string_view, Row &)`, which
+ * returns false for rows to skip; Row must have a `local_timestamp`.
+ */
+class CSVCursor {
+public:
+  /**
+   * @brief Opens a CSV file, skips its header and loads its index.
+   *
+   * @param filename Path to the CSV file.
+   * @param buffer_size Size of the read-ahead buffer in bytes.
+   *
+   * @throws std::runtime_error If the file cannot be opened.
+   */
+  CSVCursor(const std::string &filename, std::size_t buffer_size);
+
+  /**
+   * @brief Parses the next row into `row`.
+   *
+   * After a seek() the row it found, already in `row`, is returned first.
+   *
+   * @return false When the file is exhausted.
+   */
+  template <class Row, class Parse> bool next(Row &row, Parse &&parse) {
+    if (has_pending_) {
+      has_pending_ = false;
+      return true;
+    }
+
+    std::string_view line;
+    while (reader_.next_line(line)) {
+      if (parse(line, row)) {
+        last_timestamp_ = row.local_timestamp;
+        return true;
+      }
+      logging::Logger::debug("Skipping malformed line: ", line);
+    }
+    return false;
+  }
+
+  /**
+   * @brief Moves to the first row at or after `timestamp` and parses it
+   * into `row`; the next call to next() returns it.
+   *
+   * @return true If the cursor moved.
+   * @return false If the reader cannot seek; the cursor is left untouched.
+   */
+  template <class Row, class Parse>
+  bool seek(long long timestamp, Row &row, Parse &&parse) {
+    if (!reposition(timestamp)) {
+      return false;
+    }
+
+    std::string_view line;
+    long long line_timestamp = 0;
+    while (reader_.next_line(line)) {
+      if (!line_parsers::parse_timestamp(line, line_timestamp)) {
+        continue;
+      }
+      last_timestamp_ = line_timestamp;
+      if (line_timestamp >= timestamp && parse(line, row)) {
+        has_pending_ = true;
+        break;
+      }
+    }
+    return true;
+  }
+
+private:
+  /// Moves the reader to a row at or before the first one at `timestamp`.
+  bool reposition(long long timestamp);
+
+  /// Reopens the file and skips its header.
+  void rewind();
+
+private:
+  std::string filename_;    ///< Path to the CSV file.
+  std::size_t buffer_size_; ///< Size of the read-ahead buffer.
+  LineReader reader_;       ///< Buffered reader over the file.
+  TimestampIndex index_;    ///< Sparse index, empty if none.
+  bool has_pending_{false}; ///< The caller's row was found by seek().
+  /// Timestamp of the last row read from the file.
+  long long last_timestamp_{std::numeric_limits<long long>::min()};
+};
+
+} // namespace data_loading
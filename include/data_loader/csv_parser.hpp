@@ -1,5 +1,6 @@
 #pragma once
 
+#include "data_loader/parser_abstract.hpp"
 #include "types.hpp"
 #include <string>
 #include <vector>
@@ -10,9 +11,10 @@ namespace data_loading {
  * @brief A simple CSV parser for loading LOB and trades data.
  *
  * This class parses CSV files containing limit order book (LOB) snapshots
- * and trade records, returning them as vectors of structured data.
+ * and trade records, returning them as vectors of structured data. Gzip
+ * compressed files are detected and inflated on a background thread.
  */
-class CSVParser {
+class CSVParser final : public ParserAbstract {
 public:
   /**
    * @brief Default constructor.
@@ -34,7 +36,8 @@ public:
    * @param filename Path to the LOB CSV file.
    * @return std::vector<raw_data::LOBData> Vector of LOB data entries.
    */
-  std::vector<raw_data::LOBData> parse_lob(const std::string &filename);
+  std::vector<raw_data::LOBData>
+  parse_lob(const std::string &filename) override;
 
   /**
    * @brief Parses a trades CSV file into structured TradeData.
@@ -42,7 +45,8 @@ public:
    * @param filename Path to the trades CSV file.
    * @return std::vector<raw_data::TradeData> Vector of trade data entries.
    */
-  std::vector<raw_data::TradeData> parse_trades(const std::string &filename);
+  std::vector<raw_data::TradeData>
+  parse_trades(const std::string &filename) override;
 
 private:
   /// Maximum depth level to read from LOB CSV files. Default is 25 as in given
@@ -0,0 +1,147 @@
+#pragma once
+
+#include "data_loader/market_data_source.hpp"
+#include "types.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace data_loading {
+
+/**
+ * @brief Delta-encoded in-memory storage of LOB snapshots.
+ *
+ * Consecutive snapshots usually differ in one or two levels, so only the
+ * changed levels are stored. A full keyframe is written every
+ * `keyframe_interval` snapshots (or earlier, when a delta would be larger
+ * than the book itself), which bounds the replay cost of random access.
+ */
+class DeltaLOBStore {
+public:
+  /// Default number of snapshots between two keyframes.
+  static constexpr std::size_t DEFAULT_KEYFRAME_INTERVAL = 256;
+
+  /**
+   * @brief Constructs an empty store.
+   *
+   * @param keyframe_interval Maximum number of snapshots between keyframes.
+   */
+  explicit DeltaLOBStore(
+      std::size_t keyframe_interval = DEFAULT_KEYFRAME_INTERVAL);
+
+  /**
+   * @brief Builds a store from a vector of snapshots.
+   *
+   * @param lob_data Snapshots to encode.
+   * @param keyframe_interval Maximum number of snapshots between keyframes.
+   * @return DeltaLOBStore Encoded store.
+   */
+  static DeltaLOBStore
+  build(const std::vector<raw_data::LOBData> &lob_data,
+        std::size_t keyframe_interval = DEFAULT_KEYFRAME_INTERVAL);
+
+  /**
+   * @brief Appends the next snapshot, storing only levels that changed.
+   *
+   * @param snapshot Snapshot following the last appended one.
+   */
+  void append(const raw_data::LOBData &snapshot);
+
+  /** @brief Returns number of stored snapshots. */
+  inline std::size_t size() const noexcept { return records_.size(); }
+
+  /** @brief Returns approximate heap memory used by the store in bytes. */
+  std::size_t memory_usage() const noexcept;
+
+  /**
+   * @brief Turns `book` (snapshot i - 1) into snapshot i.
+   *
+   * Keyframes are copied as a whole; other snapshots apply their level
+   * deltas in place, so replaying in order costs O(changed levels).
+   *
+   * @param i Index of the snapshot to build.
+   * @param book Snapshot i - 1 on input (ignored when i is a keyframe).
+   */
+  void advance(std::size_t i, raw_data::LOBData &book) const;
+
+  /**
+   * @brief Reconstructs an arbitrary snapshot.
+   *
+   * Replays deltas from the closest preceding keyframe.
+   *
+   * @param i Index of the snapshot.
+   * @param out Destination snapshot.
+   */
+  void snapshot_at(std::size_t i, raw_data::LOBData &out) const;
+
+  /**
+   * @brief Finds the first snapshot at or after `timestamp`.
+   *
+   * @param timestamp Timestamp to look for.
+   * @return std::size_t Index of the snapshot, size() if there is none.
+   */
+  std::size_t lower_bound(long long timestamp) const noexcept;
+
+private:
+  /// @brief One changed level of one side.
+  struct LevelDelta {
+    raw_data::OrderBookEntry entry; ///< New level content.
+    std::uint16_t level;            ///< Level index.
+    bool is_bid;                    ///< Side of the level.
+  };
+
+  /// @brief Per-snapshot bookkeeping.
+  struct Record {
+    long long local_timestamp; ///< Snapshot timestamp.
+    std::uint32_t offset;      ///< First delta or keyframe level.
+    std::uint16_t delta_count; ///< Number of deltas (0 for keyframes).
+    std::uint16_t ask_count;   ///< Ask levels after this snapshot.
+    std::uint16_t bid_count;   ///< Bid levels after this snapshot.
+    bool keyframe;             ///< Snapshot stored in full.
+  };
+
+  /// Stores the snapshot in full as a keyframe.
+  void append_keyframe(const raw_data::LOBData &snapshot);
+
+  /// Appends deltas for levels of `side` that differ from `prev_side`.
+  template <typename Side>
+  void push_deltas(const Side &prev_side, const Side &side, bool is_bid);
+
+private:
+  std::size_t keyframe_interval_;  ///< Maximum snapshots between keyframes.
+  std::size_t since_keyframe_{0};  ///< Snapshots since the last keyframe.
+  std::vector<Record> records_;    ///< One record per snapshot.
+  std::vector<LevelDelta> deltas_; ///< Level deltas of all snapshots.
+  /// Levels of all keyframes: asks followed by bids.
+  std::vector<raw_data::OrderBookEntry> keyframe_levels_;
+  raw_data::LOBData last_; ///< Last appended snapshot, used for diffing.
+};
+
+/**
+ * @brief Snapshot source replaying a DeltaLOBStore incrementally.
+ *
+ * Keeps a single live book and applies each snapshot's deltas to it as the
+ * engine advances.
+ */
+class DeltaDataSource final : public MarketDataSource {
+public:
+  /**
+   * @brief Constructs the source over a shared store.
+   *
+   * @param store Delta-encoded snapshots.
+   */
+  explicit DeltaDataSource(std::shared_ptr<const DeltaLOBStore> store);
+
+  const raw_data::LOBData *next() override;
+
+  /** @brief Rebuilds the live book from the keyframe before `timestamp`. */
+  bool seek(long long timestamp) override;
+
+private:
+  std::shared_ptr<const DeltaLOBStore> store_; ///< Encoded snapshots.
+  std::size_t cursor_{0};                      ///< Index of the next row.
+  raw_data::LOBData book_; ///< Live book rebuilt incrementally.
+};
+
+} // namespace data_loading
@@ -0,0 +1,175 @@
+#pragma once
+
+#include "data_loader/market_data_source.hpp"
+#include "data_loader/trade_data_source.hpp"
+#include "types.hpp"
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace data_loading {
+
+/// @brief Kind of a market event.
+enum class EventType {
+  Snapshot, ///< LOB snapshot, `snapshot` is set.
+  Trade     ///< Market trade print, `trade` is set.
+};
+
+/// @brief One timestamped market event of a merged feed.
+struct MarketEvent {
+  EventType type{EventType::Snapshot};        ///< Kind of the event.
+  long long local_timestamp{0};               ///< Timestamp of the event.
+  const raw_data::LOBData *snapshot{nullptr}; ///< Snapshot events only.
+  const raw_data::TradeData *trade{nullptr};  ///< Trade events only.
+};
+
+/**
+ * @brief Abstract source of timestamp-ordered market events.
+ *
+ * Adapts one data feed (snapshots, trades, ...) to the EventStream merge.
+ */
+class EventSourceAbstract {
+public:
+  /// Unique pointer alias for convenience.
+  using UPtr = std::unique_ptr<EventSourceAbstract>;
+
+  /// Virtual destructor for proper cleanup in derived classes.
+  virtual ~EventSourceAbstract() = default;
+
+  /**
+   * @brief Pulls the next event of the feed.
+   *
+   * Pointers stored in `event` stay valid until the following call.
+   *
+   * @param event Output event.
+   * @return true If an event was read, false when the feed is exhausted.
+   */
+  virtual bool next(MarketEvent &event) = 0;
+
+  /**
+   * @brief Moves to the first event at or after `timestamp`.
+   *
+   * @param timestamp Timestamp to move to.
+   * @return true If the feed moved, false if it cannot seek.
+   */
+  virtual bool seek(long long /*timestamp*/) { return false; }
+};
+
+/// @brief Event source over a MarketDataSource (not owned).
+class SnapshotEventSource final : public EventSourceAbstract {
+public:
+  /**
+   * @brief Constructs the adapter.
+   *
+   * @param source Snapshot source; must outlive the adapter.
+   */
+  explicit SnapshotEventSource(MarketDataSource &source) : source_(source) {}
+
+  bool next(MarketEvent &event) override;
+
+  inline bool seek(long long timestamp) override {
+    return source_.seek(timestamp);
+  }
+
+private:
+  MarketDataSource &source_; ///< Wrapped snapshot source.
+};
+
+/// @brief Event source over a TradeDataSource (not owned).
+class TradeEventSource final : public EventSourceAbstract {
+public:
+  /**
+   * @brief Constructs the adapter.
+   *
+   * @param source Trade source; must outlive the adapter.
+   */
+  explicit TradeEventSource(TradeDataSource &source) : source_(source) {}
+
+  bool next(MarketEvent &event) override;
+
+  inline bool seek(long long timestamp) override {
+    return source_.seek(timestamp);
+  }
+
+private:
+  TradeDataSource &source_; ///< Wrapped trade source.
+};
+
+/**
+ * @brief K-way merge of several event sources ordered by `local_timestamp`.
+ *
+ * The head event of every source is kept in a binary min-heap, so each
+ * event costs O(log k) for k sources. Events with equal timestamps are
+ * returned in the order their sources were added. A source is advanced only
+ * when the next event is requested, so the returned event stays valid until
+ * then.
+ */
+class EventStream {
+public:
+  /**
+   * @brief Adds a feed to the merge.
+   *
+   * @param source Event source; owned by the stream.
+   */
+  void add_source(EventSourceAbstract::UPtr &&source);
+
+  /**
+   * @brief Returns the next event across all sources.
+   *
+   * @return const MarketEvent* Pointer to the event, valid until the
+   * following call, or nullptr when every source is exhausted.
+   */
+  const MarketEvent *next();
+
+  /**
+   * @brief Seeks every source to `timestamp`.
+   *
+   * Sources that cannot seek keep their position.
+   *
+   * @param timestamp Timestamp to move to.
+   * @return true If all sources moved.
+   */
+  bool seek(long long timestamp);
+
+  /** @brief Returns number of merged sources. */
+  inline std::size_t source_count() const noexcept { return sources_.size(); }
+
+private:
+  /// @brief Head event of one source.
+  struct Head {
+    MarketEvent event;  ///< Next event of the source.
+    std::size_t source; ///< Index of the source in sources_.
+  };
+
+  /// Heap order: true if `lhs` must be returned after `rhs`.
+  static inline bool later(const Head &lhs, const Head &rhs) noexcept {
+    return lhs.event.local_timestamp != rhs.event.local_timestamp
+               ? lhs.event.local_timestamp > rhs.event.local_timestamp
+               : lhs.source > rhs.source;
+  }
+
+  /// Reads the next event of `source` into the heap.
+  void pull(std::size_t source);
+
+private:
+  std::vector<EventSourceAbstract::UPtr> sources_; ///< Merged feeds.
+  std::vector<Head> heap_;          ///< Head events, earliest on top.
+  std::vector<std::size_t> stale_;  ///< Sources to pull before next event.
+  Head current_{};                  ///< Event returned by the last next().
+  bool has_current_{false};         ///< current_ still holds a live event.
+};
+
+/**
+ * @brief Factory function to create a unique pointer to a given source type.
+ *
+ * @tparam SourceT Concrete event source class.
+ * @param args Arguments forwarded to the source constructor.
+ * @return UPtr Unique pointer to the created source.
+ */
+template <typename SourceT, typename... Args>
+EventSourceAbstract::UPtr create_event_source(Args &&...args) {
+  return std::make_unique<SourceT>(std::forward<Args>(args)...);
+}
+
+} // namespace data_loading
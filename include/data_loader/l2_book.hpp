@@ -0,0 +1,137 @@
+#pragma once
+
+#include "data_loader/line_reader.hpp"
+#include "data_loader/market_data_source.hpp"
+#include "data_loader/snapshot_cadence.hpp"
+#include "types.hpp"
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace data_loading {
+
+/**
+ * @brief Reads an incremental L2 CSV file into memory.
+ *
+ * Lines that cannot be parsed are skipped. Plain and gzip compressed files
+ * are accepted.
+ *
+ * @param filename Path to the L2 updates CSV file.
+ * @param scale Scale prices and amounts are converted to.
+ * @return std::vector<raw_data::L2Update> Updates in file order.
+ *
+ * @throws std::runtime_error If the file cannot be opened.
+ */
+std::vector<raw_data::L2Update>
+load_l2_updates(const std::string &filename,
+                const common_types::InstrumentScale &scale = {});
+
+/**
+ * @brief Live L2 order book rebuilt from incremental level updates.
+ *
+ * Each side is a vector sorted so that the best level is at the back:
+ * updates cluster around the top of the book, where inserting and erasing
+ * only moves a few elements.
+ */
+class L2BookBuilder {
+public:
+  /**
+   * @brief Applies one level update.
+   *
+   * @param update Level update; a non-positive amount removes the level.
+   */
+  void apply(const raw_data::L2Update &update);
+
+  /** @brief Removes every level. */
+  void clear() noexcept;
+
+  /**
+   * @brief Writes the top of the book into a snapshot.
+   *
+   * Only the sides are written; the timestamp is left to the caller.
+   *
+   * @param depth Maximum number of levels per side.
+   * @param out Destination snapshot.
+   */
+  void snapshot(std::size_t depth, raw_data::LOBData &out) const;
+
+  /** @brief Returns number of ask levels. */
+  inline std::size_t ask_levels() const noexcept { return asks_.size(); }
+
+  /** @brief Returns number of bid levels. */
+  inline std::size_t bid_levels() const noexcept { return bids_.size(); }
+
+private:
+  /// Asks by descending price, best (lowest) ask last.
+  std::vector<raw_data::OrderBookEntry> asks_;
+  /// Bids by ascending price, best (highest) bid last.
+  std::vector<raw_data::OrderBookEntry> bids_;
+};
+
+/**
+ * @brief Snapshot source rebuilding the book from incremental L2 updates.
+ *
+ * Updates sharing a timestamp are applied together, so no half-applied book
+ * is ever published; see SnapshotCadence for when snapshots are emitted.
+ * Nothing is published before both sides of the book have a level.
+ */
+class L2DataSource final : public MarketDataSource {
+public:
+  /**
+   * @brief Streams updates from an L2 CSV file.
+   *
+   * @param filename Path to the L2 updates CSV file.
+   * @param lob_depth_level Number of levels per side in emitted snapshots.
+   * @param cadence Minimum time between snapshots, 0 for every update.
+   * @param scale Scale prices and amounts are converted to.
+   *
+   * @throws std::runtime_error If the file cannot be opened.
+   */
+  explicit L2DataSource(const std::string &filename,
+                        const int lob_depth_level = 25,
+                        long long cadence = 0,
+                        const common_types::InstrumentScale &scale = {});
+
+  /**
+   * @brief Replays updates already held in memory.
+   *
+   * @param updates Updates sorted by timestamp.
+   * @param lob_depth_level Number of levels per side in emitted snapshots.
+   * @param cadence Minimum time between snapshots, 0 for every update.
+   */
+  explicit L2DataSource(
+      std::shared_ptr<const std::vector<raw_data::L2Update>> updates,
+      const int lob_depth_level = 25, long long cadence = 0);
+
+  const raw_data::LOBData *next() override;
+
+private:
+  /// Reads the next update from the file or the vector.
+  bool read_update(raw_data::L2Update &update);
+
+  /// Copies the book into current_.
+  const raw_data::LOBData *publish();
+
+  /// True once the book may be published: the first snapshot is held back
+  /// until both sides have a level, so a backtest never starts one-sided.
+  inline bool publishable() const noexcept {
+    return published_ || (book_.ask_levels() > 0 && book_.bid_levels() > 0);
+  }
+
+private:
+  std::unique_ptr<LineReader> reader_;  ///< File reader, null for vectors.
+  common_types::InstrumentScale scale_; ///< Scale of prices and amounts.
+  /// In-memory updates, null for files.
+  std::shared_ptr<const std::vector<raw_data::L2Update>> updates_;
+  std::size_t cursor_{0};        ///< Next in-memory update.
+  std::size_t depth_;            ///< Levels per side of emitted snapshots.
+  SnapshotCadence cadence_;      ///< When to publish the book.
+  L2BookBuilder book_;           ///< Live book.
+  raw_data::L2Update pending_{}; ///< Update read but not applied yet.
+  bool has_pending_{false};      ///< pending_ holds an update.
+  raw_data::LOBData current_;    ///< Snapshot returned by the last next().
+  bool published_{false};        ///< A snapshot was published.
+};
+
+} // namespace data_loading
@@ -0,0 +1,246 @@
+#pragma once
+
+#include "data_loader/line_reader.hpp"
+#include "data_loader/market_data_source.hpp"
+#include "data_loader/snapshot_cadence.hpp"
+#include "types.hpp"
+#include "utils/id_map.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace data_loading {
+
+/**
+ * @brief Reads an order-by-order (L3) CSV file into memory.
+ *
+ * Lines that cannot be parsed are skipped. Plain and gzip compressed files
+ * are accepted.
+ *
+ * @param filename Path to the L3 events CSV file.
+ * @param scale Scale prices and amounts are converted to.
+ * @return std::vector<raw_data::L3Event> Events in file order.
+ *
+ * @throws std::runtime_error If the file cannot be opened.
+ */
+std::vector<raw_data::L3Event>
+load_l3_events(const std::string &filename,
+               const common_types::InstrumentScale &scale = {});
+
+/**
+ * @brief Order-level book keeping a FIFO queue of orders per price.
+ *
+ * Orders are nodes of one pooled vector, chained into per-level intrusive
+ * doubly linked lists by index; freed nodes go to a free list and are
+ * reused, so steady-state replay does not allocate. Order ids are resolved
+ * through an open-addressing IdMap. Levels of each side are kept in a
+ * vector sorted so that the best level is at the back, like L2BookBuilder.
+ */
+class L3OrderBook {
+public:
+  /**
+   * @brief Constructs an empty book.
+   *
+   * @param expected_orders Number of resting orders to preallocate for.
+   */
+  explicit L3OrderBook(std::size_t expected_orders = 1 << 16);
+
+  /**
+   * @brief Applies one L3 event.
+   *
+   * @param event Event to apply.
+   * @return true If applied, false if it refers to an unknown order, adds a
+   * duplicate id or has an undefined side.
+   */
+  bool apply(const raw_data::L3Event &event);
+
+  /**
+   * @brief Adds an order at the back of its price level.
+   *
+   * @return true If added, false on a duplicate id, undefined side or
+   * non-positive amount.
+   */
+  bool add(std::uint64_t order_id, common_types::Side side,
+           common_types::Price price, common_types::Amount amount);
+
+  /**
+   * @brief Changes price and/or amount of an order.
+   *
+   * Reducing the amount at the same price keeps queue priority; a price
+   * change or an increase moves the order to the back of the queue. A
+   * non-positive amount cancels the order.
+   *
+   * @return true If the order exists.
+   */
+  bool modify(std::uint64_t order_id, common_types::Price price,
+              common_types::Amount amount);
+
+  /**
+   * @brief Removes an order.
+   *
+   * @return true If the order existed.
+   */
+  bool cancel(std::uint64_t order_id);
+
+  /**
+   * @brief Fills part of an order; a fully filled order is removed.
+   *
+   * @return true If the order exists.
+   */
+  bool execute(std::uint64_t order_id, common_types::Amount amount);
+
+  /** @brief Removes every order, keeping the allocated pools. */
+  void clear() noexcept;
+
+  /**
+   * @brief Aggregates the top of the book into a snapshot.
+   *
+   * Only the sides are written; the timestamp is left to the caller.
+   *
+   * @param depth Maximum number of levels per side.
+   * @param out Destination snapshot.
+   */
+  void snapshot(std::size_t depth, raw_data::LOBData &out) const;
+
+  /**
+   * @brief Returns the amount resting ahead of an order at its level.
+   *
+   * @param order_id Order to look up.
+   * @param ahead Output amount of older orders at the same price.
+   * @return true If the order exists.
+   */
+  bool queue_ahead(std::uint64_t order_id, common_types::Amount &ahead) const;
+
+  /** @brief Returns number of resting orders. */
+  inline std::size_t order_count() const noexcept { return ids_.size(); }
+
+  /** @brief Returns number of ask levels. */
+  inline std::size_t ask_levels() const noexcept { return asks_.size(); }
+
+  /** @brief Returns number of bid levels. */
+  inline std::size_t bid_levels() const noexcept { return bids_.size(); }
+
+private:
+  /// Index meaning "no node".
+  static constexpr std::uint32_t NIL =
+      std::numeric_limits<std::uint32_t>::max();
+
+  /// @brief Resting order; a node of the per-level intrusive list.
+  struct OrderNode {
+    std::uint64_t id;            ///< Exchange order id.
+    common_types::Price price;   ///< Order price.
+    common_types::Amount amount; ///< Remaining amount.
+    std::uint32_t prev;          ///< Older order at the level, or NIL.
+    std::uint32_t next;          ///< Newer order (or next free node), or NIL.
+    common_types::Side side;     ///< Buy for bids, Sell for asks.
+  };
+
+  /// @brief Aggregated price level with its FIFO queue of orders.
+  struct Level {
+    common_types::Price price;  ///< Level price.
+    common_types::Amount total; ///< Sum of the order amounts.
+    std::uint32_t head;         ///< Oldest order.
+    std::uint32_t tail;         ///< Newest order.
+  };
+
+  using Levels = std::vector<Level>;
+
+  /// Takes a node from the free list or grows the pool.
+  std::uint32_t allocate();
+
+  /// Returns a node to the free list.
+  void release(std::uint32_t node) noexcept;
+
+  /// Returns the level vector of `side`.
+  inline Levels &levels(common_types::Side side) noexcept {
+    return side == common_types::Side::Buy ? bids_ : asks_;
+  }
+
+  /// Finds the position of `price` in `side`, or where it would go.
+  Levels::iterator locate(common_types::Side side, common_types::Price price);
+
+  /// Appends a node to the queue of its price, creating the level.
+  void link(std::uint32_t node);
+
+  /// Removes a node from its queue, erasing the level when it empties.
+  void unlink(std::uint32_t node);
+
+private:
+  std::vector<OrderNode> nodes_;    ///< Pool of order nodes.
+  std::uint32_t free_head_{NIL};    ///< First free node.
+  Levels asks_;                     ///< Asks, best (lowest) last.
+  Levels bids_;                     ///< Bids, best (highest) last.
+  utils::IdMap<std::uint32_t> ids_; ///< Order id -> node index.
+};
+
+/**
+ * @brief Snapshot source replaying L3 events through an L3OrderBook.
+ *
+ * Publishes aggregated snapshots like L2DataSource; the order-level book is
+ * available through book() for queue modelling.
+ */
+class L3DataSource final : public MarketDataSource {
+public:
+  /**
+   * @brief Streams events from an L3 CSV file.
+   *
+   * @param filename Path to the L3 events CSV file.
+   * @param lob_depth_level Number of levels per side in emitted snapshots.
+   * @param cadence Minimum time between snapshots, 0 for every update.
+   * @param scale Scale prices and amounts are converted to.
+   *
+   * @throws std::runtime_error If the file cannot be opened.
+   */
+  explicit L3DataSource(const std::string &filename,
+                        const int lob_depth_level = 25,
+                        long long cadence = 0,
+                        const common_types::InstrumentScale &scale = {});
+
+  /**
+   * @brief Replays events already held in memory.
+   *
+   * @param events Events sorted by timestamp.
+   * @param lob_depth_level Number of levels per side in emitted snapshots.
+   * @param cadence Minimum time between snapshots, 0 for every update.
+   */
+  explicit L3DataSource(
+      std::shared_ptr<const std::vector<raw_data::L3Event>> events,
+      const int lob_depth_level = 25, long long cadence = 0);
+
+  const raw_data::LOBData *next() override;
+
+  /** @brief Returns the order-level book as of the last snapshot. */
+  inline const L3OrderBook &book() const noexcept { return book_; }
+
+private:
+  /// Reads the next event from the file or the vector.
+  bool read_event(raw_data::L3Event &event);
+
+  /// Aggregates the book into current_.
+  const raw_data::LOBData *publish();
+
+  /// True once the book may be published: the first snapshot is held back
+  /// until both sides have a level, so a backtest never starts one-sided.
+  inline bool publishable() const noexcept {
+    return published_ || (book_.ask_levels() > 0 && book_.bid_levels() > 0);
+  }
+
+private:
+  std::unique_ptr<LineReader> reader_;  ///< File reader, null for vectors.
+  common_types::InstrumentScale scale_; ///< Scale of prices and amounts.
+  /// In-memory events, null for files.
+  std::shared_ptr<const std::vector<raw_data::L3Event>> events_;
+  std::size_t cursor_{0};       ///< Next in-memory event.
+  std::size_t depth_;           ///< Levels per side of emitted snapshots.
+  SnapshotCadence cadence_;     ///< When to publish the book.
+  L3OrderBook book_;            ///< Live order-level book.
+  raw_data::L3Event pending_{}; ///< Event read but not applied yet.
+  bool has_pending_{false};     ///< pending_ holds an event.
+  raw_data::LOBData current_;   ///< Snapshot returned by the last next().
+  bool published_{false};       ///< A snapshot was published.
+};
+
+} // namespace data_loading
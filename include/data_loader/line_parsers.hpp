@@ -0,0 +1,91 @@
+#pragma once
+
+#include "types.hpp"
+#include <string_view>
+
+namespace data_loading {
+
+/**
+ * @brief Allocation-free parsers for single CSV lines.
+ *
+ * The functions scan fields in place with std::from_chars and follow the
+ * same rules as CSVParser: the first column (row index) is skipped, a line
+ * with a bad timestamp is rejected, levels with a malformed cell are skipped
+ * and levels with non-positive price or amount are dropped. Prices and
+ * amounts are converted with the given instrument scale.
+ */
+namespace line_parsers {
+
+/**
+ * @brief Parses only the timestamp column of a LOB or trades CSV line.
+ *
+ * @param line Line without the trailing '\n'.
+ * @param timestamp Output timestamp.
+ * @return true If the line holds a valid timestamp.
+ */
+bool parse_timestamp(std::string_view line, long long &timestamp);
+
+/**
+ * @brief Parses one LOB CSV line into a snapshot.
+ *
+ * @param line Line without the trailing '\n'.
+ * @param lob_depth_level Maximum number of levels to read, capped at
+ * raw_data::MAX_LOB_DEPTH.
+ * @param scale Scale prices and amounts are converted to.
+ * @param entry Output snapshot; its ask and bid sides are cleared first.
+ * @return true If the line holds a valid timestamp.
+ * @return false If the line must be skipped.
+ */
+bool parse_lob_line(std::string_view line, int lob_depth_level,
+                    const common_types::InstrumentScale &scale,
+                    raw_data::LOBData &entry);
+
+/**
+ * @brief Parses one trades CSV line into a trade record.
+ *
+ * @param line Line without the trailing '\n'.
+ * @param scale Scale prices and amounts are converted to.
+ * @param trade Output trade record.
+ * @return true If timestamp, price and amount were parsed.
+ * @return false If the line must be skipped.
+ */
+bool parse_trade_line(std::string_view line,
+                      const common_types::InstrumentScale &scale,
+                      raw_data::TradeData &trade);
+
+/**
+ * @brief Parses one incremental L2 CSV line into a level update.
+ *
+ * Expected columns: row index, local_timestamp, side (bid/buy or ask/sell),
+ * price, amount.
+ *
+ * @param line Line without the trailing '\n'.
+ * @param scale Scale prices and amounts are converted to.
+ * @param update Output level update.
+ * @return true If all columns were parsed and the side is known.
+ * @return false If the line must be skipped.
+ */
+bool parse_l2_update_line(std::string_view line,
+                          const common_types::InstrumentScale &scale,
+                          raw_data::L2Update &update);
+
+/**
+ * @brief Parses one order-by-order (L3) CSV line into an event.
+ *
+ * Expected columns: row index, local_timestamp, order_id, action
+ * (add/modify/cancel/execute), side (bid/buy or ask/sell), price, amount.
+ * Price and amount may be empty for cancels.
+ *
+ * @param line Line without the trailing '\n'.
+ * @param scale Scale prices and amounts are converted to.
+ * @param event Output event.
+ * @return true If the line holds a valid event.
+ * @return false If the line must be skipped.
+ */
+bool parse_l3_event_line(std::string_view line,
+                         const common_types::InstrumentScale &scale,
+                         raw_data::L3Event &event);
+
+} // namespace line_parsers
+
+} // namespace data_loading
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "data_loader/byte_source.hpp"
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace data_loading {
+
+/**
+ * @brief Reads a text file line by line through a fixed read-ahead buffer.
+ *
+ * Lines are returned as views into the internal buffer, so memory use stays
+ * bounded by the buffer size (grown only for lines longer than it) no matter
+ * how large the file is. Gzip compressed files are detected and inflated on
+ * the fly.
+ */
+class LineReader {
+public:
+  /// Default size of the read-ahead buffer in bytes.
+  static constexpr std::size_t DEFAULT_BUFFER_SIZE = 1 << 20;
+
+  /**
+   * @brief Opens a plain or gzip compressed file for reading.
+   *
+   * @param filename Path to the file.
+   * @param buffer_size Size of the read-ahead buffer in bytes.
+   *
+   * @throws std::runtime_error If the file cannot be opened.
+   */
+  explicit LineReader(const std::string &filename,
+                      std::size_t buffer_size = DEFAULT_BUFFER_SIZE);
+
+  /**
+   * @brief Returns the next line without the trailing '\n'.
+   *
+   * The view stays valid until the next call.
+   *
+   * @param line Output view of the line.
+   * @return true If a line was read.
+   * @return false At end of file.
+   */
+  bool next_line(std::string_view &line);
+
+  /**
+   * @brief Continues reading from an absolute byte offset.
+   *
+   * Only plain files can seek; compressed input returns false.
+   *
+   * @param offset Offset of a line start in the file.
+   * @return true If the reader moved to `offset`.
+   */
+  bool seek(std::size_t offset);
+
+private:
+  /// Moves unread bytes to the front and fills the rest from the file.
+  bool refill();
+
+private:
+  ByteSourceAbstract::UPtr source_; ///< Underlying byte source.
+  std::vector<char> buffer_;        ///< Read-ahead buffer.
+  std::size_t pos_{0};       ///< Start of unread data in buffer_.
+  std::size_t end_{0};       ///< End of valid data in buffer_.
+  bool eof_{false};          ///< Set once the file is exhausted.
+};
+
+} // namespace data_loading
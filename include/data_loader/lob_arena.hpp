@@ -0,0 +1,150 @@
+#pragma once
+
+#include "data_loader/market_data_source.hpp"
+#include "types.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace data_loading {
+
+/**
+ * @brief Lightweight view of one snapshot stored in a LOBArena.
+ *
+ * Points into the arena, so it is only valid while the arena lives.
+ */
+struct LOBView {
+  long long local_timestamp;               ///< Timestamp of the snapshot.
+  const common_types::Price *ask_prices;   ///< Ask prices, best first.
+  const common_types::Amount *ask_amounts; ///< Ask amounts.
+  std::size_t ask_count;                   ///< Number of ask levels.
+  const common_types::Price *bid_prices;   ///< Bid prices, best first.
+  const common_types::Amount *bid_amounts; ///< Bid amounts.
+  std::size_t bid_count;                   ///< Number of bid levels.
+
+  /**
+   * @brief Copies the snapshot into `out`.
+   *
+   * @param out Destination snapshot.
+   */
+  void copy_to(raw_data::LOBData &out) const;
+};
+
+/**
+ * @brief Whole snapshot dataset packed into one contiguous memory arena.
+ *
+ * A vector of LOBData reserves MAX_LOB_DEPTH levels per side for every
+ * snapshot. The arena stores only the levels each snapshot actually has,
+ * back to back in replay order (ask prices, ask amounts, bid prices, bid
+ * amounts), after a table of per-snapshot records. Everything lives in one
+ * anonymous mapping, optionally backed by transparent huge pages, so the
+ * dataset is released with a single munmap and in-order replay reads
+ * memory strictly sequentially.
+ */
+class LOBArena {
+public:
+  /// Constructs an empty arena.
+  LOBArena() = default;
+
+  /**
+   * @brief Packs a vector of snapshots into a new arena.
+   *
+   * @param lob_data Snapshots sorted by timestamp.
+   * @param huge_pages Ask the kernel to back the arena with huge pages.
+   * @return LOBArena Arena holding a copy of the snapshots.
+   *
+   * @throws std::runtime_error If the memory cannot be mapped.
+   */
+  static LOBArena build(const std::vector<raw_data::LOBData> &lob_data,
+                        bool huge_pages = true);
+
+  ~LOBArena();
+
+  LOBArena(const LOBArena &) = delete;
+  LOBArena &operator=(const LOBArena &) = delete;
+
+  LOBArena(LOBArena &&other) noexcept;
+  LOBArena &operator=(LOBArena &&other) noexcept;
+
+  /** @brief Returns number of stored snapshots. */
+  inline std::size_t size() const noexcept { return size_; }
+
+  /** @brief Returns size of the mapping in bytes. */
+  inline std::size_t memory_usage() const noexcept { return bytes_; }
+
+  /** @brief Returns true if the kernel accepted the huge page advice. */
+  inline bool huge_pages() const noexcept { return huge_pages_; }
+
+  /**
+   * @brief Returns a view of snapshot `i`.
+   *
+   * @param i Index below size().
+   */
+  LOBView view(std::size_t i) const noexcept;
+
+  /**
+   * @brief Copies snapshot `i` into `out`.
+   *
+   * @param i Index below size().
+   * @param out Destination snapshot.
+   */
+  inline void load(std::size_t i, raw_data::LOBData &out) const {
+    view(i).copy_to(out);
+  }
+
+  /**
+   * @brief Finds the first snapshot at or after `timestamp`.
+   *
+   * @param timestamp Timestamp to look for.
+   * @return std::size_t Index of the snapshot, size() if there is none.
+   */
+  std::size_t lower_bound(long long timestamp) const noexcept;
+
+private:
+  /// @brief Per-snapshot bookkeeping at the start of the arena.
+  struct Record {
+    long long local_timestamp; ///< Snapshot timestamp.
+    std::uint64_t offset;      ///< First value of the snapshot's levels.
+    std::uint32_t ask_count;   ///< Number of ask levels.
+    std::uint32_t bid_count;   ///< Number of bid levels.
+  };
+
+  /// Unmaps the arena, if any.
+  void release() noexcept;
+
+private:
+  void *base_{nullptr};                        ///< Start of the mapping.
+  std::size_t bytes_{0};                       ///< Size of the mapping.
+  std::size_t size_{0};                        ///< Number of snapshots.
+  const Record *records_{nullptr};             ///< One record per snapshot.
+  const common_types::Price *values_{nullptr}; ///< Level prices and amounts.
+  bool huge_pages_{false};                     ///< Huge pages advised.
+};
+
+/**
+ * @brief Snapshot source replaying a LOBArena in order.
+ *
+ * The arena is shared, so several sources can replay the same dataset.
+ */
+class ArenaDataSource final : public MarketDataSource {
+public:
+  /**
+   * @brief Constructs the source over a shared arena.
+   *
+   * @param arena Packed snapshots.
+   */
+  explicit ArenaDataSource(std::shared_ptr<const LOBArena> arena);
+
+  const raw_data::LOBData *next() override;
+
+  /** @brief Binary searches the arena for `timestamp`. */
+  bool seek(long long timestamp) override;
+
+private:
+  std::shared_ptr<const LOBArena> arena_; ///< Packed snapshots.
+  std::size_t cursor_{0};                 ///< Index of the next snapshot.
+  raw_data::LOBData current_;             ///< Last returned snapshot.
+};
+
+} // namespace data_loading
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace data_loading {
+
+/**
+ * @brief Read-only memory mapping of a whole file.
+ *
+ * The mapping lives as long as the object and is released in the destructor.
+ * Parsers scan the mapped bytes in place instead of copying them into
+ * intermediate strings.
+ */
+class MappedFile {
+public:
+  /**
+   * @brief Maps the given file into memory.
+   *
+   * @param filename Path to the file.
+   *
+   * @throws std::runtime_error If the file cannot be opened or mapped.
+   */
+  explicit MappedFile(const std::string &filename);
+
+  ~MappedFile();
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  MappedFile(MappedFile &&other) noexcept;
+  MappedFile &operator=(MappedFile &&other) noexcept;
+
+  /** @brief Returns pointer to the first mapped byte (nullptr if empty). */
+  inline const char *data() const noexcept { return data_; }
+
+  /** @brief Returns size of the mapping in bytes. */
+  inline std::size_t size() const noexcept { return size_; }
+
+  /** @brief Returns the whole mapping as a string view. */
+  inline std::string_view view() const noexcept { return {data_, size_}; }
+
+private:
+  /// Unmaps the current region, if any.
+  void release() noexcept;
+
+private:
+  const char *data_{nullptr}; ///< Start of the mapped region.
+  std::size_t size_{0};       ///< Size of the mapped region.
+};
+
+} // namespace data_loading
@@ -0,0 +1,176 @@
+#pragma once
+
+#include "data_loader/binary_format.hpp"
+#include "data_loader/csv_cursor.hpp"
+#include "data_loader/line_reader.hpp"
+#include "types.hpp"
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace data_loading {
+
+/**
+ * @brief Abstract pull-based source of LOB snapshots.
+ *
+ * The backtest engine pulls one snapshot at a time, so implementations only
+ * need to keep the current snapshot (plus a small read-ahead buffer) in
+ * memory instead of the whole dataset.
+ */
+class MarketDataSource {
+public:
+  /// Unique pointer alias for convenience.
+  using UPtr = std::unique_ptr<MarketDataSource>;
+
+  /// Virtual destructor for proper cleanup in derived classes.
+  virtual ~MarketDataSource() = default;
+
+  /**
+   * @brief Advances to the next snapshot.
+   *
+   * @return const raw_data::LOBData* Pointer to the next snapshot, valid until
+   * the following call, or nullptr when the source is exhausted.
+   */
+  virtual const raw_data::LOBData *next() = 0;
+
+  /**
+   * @brief Moves to the first snapshot at or after `timestamp`.
+   *
+   * After a successful seek the next call to next() returns that snapshot
+   * (or nullptr if there is none). Snapshots are assumed to be sorted by
+   * timestamp. Seeking backwards is allowed.
+   *
+   * @param timestamp Timestamp to move to.
+   * @return true If the source moved.
+   * @return false If the source cannot seek; it is left untouched.
+   */
+  virtual bool seek(long long /*timestamp*/) { return false; }
+
+  /**
+   * @brief Returns true if returned snapshots stay valid as long as the
+   * source, not only until the following call to next().
+   */
+  virtual bool retains_snapshots() const noexcept { return false; }
+};
+
+/**
+ * @brief Snapshot source over an in-memory vector of snapshots.
+ *
+ * The data is shared, not copied, so several sources can replay the same
+ * dataset.
+ */
+class InMemoryDataSource final : public MarketDataSource {
+public:
+  /**
+   * @brief Constructs the source taking ownership of the snapshots.
+   *
+   * @param lob_data Snapshots to replay.
+   */
+  explicit InMemoryDataSource(std::vector<raw_data::LOBData> lob_data);
+
+  /**
+   * @brief Constructs the source over shared read-only snapshots.
+   *
+   * @param lob_data Snapshots to replay.
+   */
+  explicit InMemoryDataSource(
+      std::shared_ptr<const std::vector<raw_data::LOBData>> lob_data);
+
+  const raw_data::LOBData *next() override;
+
+  /** @brief Binary searches the snapshots for `timestamp`. */
+  bool seek(long long timestamp) override;
+
+  /** @brief Snapshots point into the shared vector. */
+  inline bool retains_snapshots() const noexcept override { return true; }
+
+private:
+  std::shared_ptr<const std::vector<raw_data::LOBData>> data_; ///< Snapshots.
+  std::size_t cursor_{0}; ///< Index of the next snapshot.
+};
+
+/**
+ * @brief Snapshot source streaming a LOB CSV file.
+ *
+ * Lines are parsed one by one from a bounded read-ahead buffer, so memory use
+ * does not depend on the file size. If a TimestampIndex built from the file
+ * is found next to it (`<file>.idx`), seek() jumps straight to the indexed
+ * row; otherwise it scans timestamps only.
+ */
+class CSVDataSource final : public MarketDataSource {
+public:
+  /**
+   * @brief Opens a LOB CSV file and skips its header.
+   *
+   * @param filename Path to the LOB CSV file.
+   * @param lob_depth_level Maximum depth level to read.
+   * @param buffer_size Size of the read-ahead buffer in bytes.
+   * @param scale Scale prices and amounts are converted to.
+   *
+   * @throws std::runtime_error If the file cannot be opened.
+   */
+  explicit CSVDataSource(
+      const std::string &filename, const int lob_depth_level = 25,
+      std::size_t buffer_size = LineReader::DEFAULT_BUFFER_SIZE,
+      const common_types::InstrumentScale &scale = {});
+
+  const raw_data::LOBData *next() override;
+
+  bool seek(long long timestamp) override;
+
+private:
+  /// Returns the row parser handed to the cursor.
+  inline auto parser() const noexcept {
+    return [this](std::string_view line, raw_data::LOBData &snapshot) {
+      return line_parsers::parse_lob_line(line, lob_depth_level_, scale_,
+                                          snapshot);
+    };
+  }
+
+private:
+  CSVCursor cursor_;                    ///< Rows of the file.
+  int lob_depth_level_;                 ///< Maximum depth level to read.
+  common_types::InstrumentScale scale_; ///< Scale of prices and amounts.
+  raw_data::LOBData current_; ///< Snapshot returned by the last next().
+};
+
+/**
+ * @brief Snapshot source reading a memory-mapped binary LOB file.
+ */
+class BinaryDataSource final : public MarketDataSource {
+public:
+  /**
+   * @brief Constructs the source over an opened binary LOB file.
+   *
+   * @param lob_file Shared pointer to the mapped file.
+   */
+  explicit BinaryDataSource(
+      std::shared_ptr<const BinaryLOBFile> lob_file);
+
+  const raw_data::LOBData *next() override;
+
+  /** @brief Binary searches the timestamp column for `timestamp`. */
+  bool seek(long long timestamp) override;
+
+private:
+  std::shared_ptr<const BinaryLOBFile> file_; ///< Mapped binary file.
+  std::size_t cursor_{0};                     ///< Index of the next row.
+  raw_data::LOBData current_; ///< Snapshot returned by the last next().
+};
+
+/**
+ * @brief Factory function to create a unique pointer to a given source type.
+ *
+ * @tparam SourceT Concrete data source class.
+ * @param args Arguments forwarded to the source constructor.
+ * @return UPtr Unique pointer to the created source.
+ */
+template <typename SourceT, typename... Args>
+MarketDataSource::UPtr create_data_source(Args &&...args) {
+  return std::make_unique<SourceT>(std::forward<Args>(args)...);
+}
+
+} // namespace data_loading
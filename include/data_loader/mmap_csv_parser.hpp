@@ -0,0 +1,65 @@
+#pragma once
+
+#include "data_loader/parser_abstract.hpp"
+#include "types.hpp"
+#include "utils/thread_pool.hpp"
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace data_loading {
+
+/**
+ * @brief Zero-copy CSV parser for LOB and trades data.
+ *
+ * Memory-maps the input file and scans every field in place with
+ * std::from_chars, so no per-line or per-cell strings are allocated. Produces
+ * the same output as CSVParser.
+ *
+ * With more than one thread the mapped file is split into chunks at line
+ * boundaries, chunks are parsed on a thread pool and the results are
+ * concatenated in file order.
+ *
+ * Gzip compressed files cannot be mapped; they are inflated on a background
+ * thread and parsed line by line instead.
+ */
+class MMapCSVParser final : public ParserAbstract {
+public:
+  /**
+   * @brief Default constructor.
+   *
+   * Uses the default LOB depth level (25).
+   */
+  MMapCSVParser() = default;
+
+  /**
+   * @brief Constructs a MMapCSVParser with a specific LOB depth level.
+   *
+   * @param lob_depth_level Maximum depth level to read from LOB CSV.
+   */
+  explicit MMapCSVParser(const int lob_depth_level);
+
+  /**
+   * @brief Constructs a MMapCSVParser parsing chunks in parallel.
+   *
+   * @param lob_depth_level Maximum depth level to read from LOB CSV.
+   * @param threads Number of parser threads; 0 means one per core.
+   */
+  MMapCSVParser(const int lob_depth_level, const std::size_t threads);
+
+  std::vector<raw_data::LOBData>
+  parse_lob(const std::string &filename) override;
+
+  std::vector<raw_data::TradeData>
+  parse_trades(const std::string &filename) override;
+
+private:
+  /// Maximum depth level to read from LOB CSV files.
+  int lob_depth_level_{25};
+
+  /// Pool for chunked parsing, nullptr in single-threaded mode.
+  std::unique_ptr<utils::ThreadPool> pool_;
+};
+
+} // namespace data_loading
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "types.hpp"
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace data_loading {
+
+/// @brief LOB snapshots and trades loaded together.
+struct MarketData {
+  std::vector<raw_data::LOBData> lob;      ///< LOB snapshots.
+  std::vector<raw_data::TradeData> trades; ///< Trade records.
+};
+
+/**
+ * @brief Abstract base class for market data file parsers.
+ *
+ * Every backend returns the same structured data, so the parser can be
+ * swapped without touching the rest of the backtest setup.
+ */
+class ParserAbstract {
+public:
+  /// Unique pointer alias for convenience.
+  using UPtr = std::unique_ptr<ParserAbstract>;
+
+  /// Virtual destructor for proper cleanup in derived classes.
+  virtual ~ParserAbstract() = default;
+
+  /**
+   * @brief Parses a LOB CSV file into structured LOBData.
+   *
+   * @param filename Path to the LOB CSV file.
+   * @return std::vector<raw_data::LOBData> Vector of LOB data entries.
+   */
+  virtual std::vector<raw_data::LOBData>
+  parse_lob(const std::string &filename) = 0;
+
+  /**
+   * @brief Parses a trades CSV file into structured TradeData.
+   *
+   * @param filename Path to the trades CSV file.
+   * @return std::vector<raw_data::TradeData> Vector of trade data entries.
+   */
+  virtual std::vector<raw_data::TradeData>
+  parse_trades(const std::string &filename) = 0;
+
+  /**
+   * @brief Loads the LOB and trades files concurrently.
+   *
+   * Each file is parsed on its own thread with parse_lob()/parse_trades().
+   *
+   * @param lob_filename Path to the LOB CSV file.
+   * @param trades_filename Path to the trades CSV file; skipped if empty.
+   * @return MarketData Both parsed datasets.
+   */
+  MarketData load(const std::string &lob_filename,
+                  const std::string &trades_filename);
+
+  /**
+   * @brief Sets the fixed-point scale prices and amounts are converted to.
+   *
+   * @param scale Scale of the instrument in the parsed files.
+   */
+  inline void set_scale(const common_types::InstrumentScale &scale) {
+    scale_ = scale;
+  }
+
+  /** @brief Returns the scale prices and amounts are converted to. */
+  inline const common_types::InstrumentScale &scale() const noexcept {
+    return scale_;
+  }
+
+protected:
+  /// Scale applied to parsed prices and amounts.
+  common_types::InstrumentScale scale_;
+};
+
+/**
+ * @brief Factory function to create a unique pointer to a given parser type.
+ *
+ * @tparam ParserT Concrete parser class.
+ * @param args Arguments forwarded to the parser constructor.
+ * @return UPtr Unique pointer to the created parser.
+ */
+template <typename ParserT, typename... Args>
+ParserAbstract::UPtr create_parser(Args &&...args) {
+  return std::make_unique<ParserT>(std::forward<Args>(args)...);
+}
+
+} // namespace data_loading
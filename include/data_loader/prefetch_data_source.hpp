@@ -0,0 +1,84 @@
+#pragma once
+
+#include "data_loader/market_data_source.hpp"
+#include "types.hpp"
+#include "utils/spsc_ring.hpp"
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <thread>
+
+namespace data_loading {
+
+/**
+ * @brief Decorator that decodes snapshots ahead on a background thread.
+ *
+ * A producer thread pulls snapshots from the wrapped source and copies them
+ * into a bounded lock-free SPSC ring while the engine thread consumes them,
+ * so parsing overlaps with simulation and total runtime approaches
+ * max(parse, simulate) instead of their sum.
+ */
+class PrefetchDataSource final : public MarketDataSource {
+public:
+  /// Default number of snapshots decoded ahead.
+  static constexpr std::size_t DEFAULT_CAPACITY = 1024;
+
+  /**
+   * @brief Starts the producer thread over the given source.
+   *
+   * @param upstream Source to prefetch from; owned by the decorator.
+   * @param capacity Ring size in snapshots, must be a power of two.
+   */
+  explicit PrefetchDataSource(MarketDataSource::UPtr &&upstream,
+                              std::size_t capacity = DEFAULT_CAPACITY);
+
+  /// Stops and joins the producer thread.
+  ~PrefetchDataSource() override;
+
+  PrefetchDataSource(const PrefetchDataSource &) = delete;
+  PrefetchDataSource &operator=(const PrefetchDataSource &) = delete;
+
+  /**
+   * @brief Returns the next prefetched snapshot.
+   *
+   * Waits for the producer when the ring is empty.
+   *
+   * @throws Rethrows any exception raised by the wrapped source.
+   */
+  const raw_data::LOBData *next() override;
+
+  /**
+   * @brief Stops the producer, seeks the wrapped source and restarts.
+   *
+   * Snapshots already decoded ahead are dropped on success and kept if the
+   * wrapped source cannot seek.
+   */
+  bool seek(long long timestamp) override;
+
+private:
+  /// Producer loop run on producer_.
+  void produce();
+
+  /// Copies a snapshot into the ring; false if asked to stop while waiting.
+  bool publish(const raw_data::LOBData &snapshot);
+
+  /// Starts the producer thread.
+  void start();
+
+  /// Asks the producer thread to exit and joins it.
+  void stop();
+
+private:
+  MarketDataSource::UPtr upstream_;         ///< Wrapped source.
+  utils::SPSCRing<raw_data::LOBData> ring_; ///< Decoded snapshots.
+  std::atomic<bool> done_{false}; ///< Producer reached end of upstream.
+  std::atomic<bool> stop_{false}; ///< Consumer asks producer to exit.
+  std::exception_ptr error_;      ///< Exception thrown by the producer.
+  bool holding_slot_{false};      ///< Consumer still owns the last slot.
+  /// Snapshot pulled from upstream when the producer was stopped.
+  raw_data::LOBData stashed_;
+  bool has_stashed_{false}; ///< stashed_ must be published first.
+  std::thread producer_;    ///< Background decoding thread.
+};
+
+} // namespace data_loading
@@ -0,0 +1,61 @@
+#pragma once
+
+namespace data_loading {
+
+/**
+ * @brief Decides when an incrementally rebuilt book is published.
+ *
+ * Updates sharing a timestamp form one atomic change, so the book is only
+ * published between two timestamps. With a zero cadence it is published
+ * after every such batch; otherwise at most once per `cadence` time units,
+ * when the first update past the boundary following the last unpublished
+ * change arrives.
+ */
+class SnapshotCadence {
+public:
+  /**
+   * @brief Constructs the policy.
+   *
+   * @param cadence Minimum time between snapshots, 0 for every update.
+   */
+  explicit SnapshotCadence(long long cadence = 0) noexcept
+      : cadence_(cadence) {}
+
+  /**
+   * @brief Checks whether the book must be published before applying an
+   * update.
+   *
+   * @param timestamp Timestamp of the update about to be applied.
+   * @return true If unpublished changes are due.
+   */
+  inline bool publish_before(long long timestamp) const noexcept {
+    return dirty_ && timestamp != book_timestamp_ &&
+           (cadence_ <= 0 || timestamp >= next_emit_);
+  }
+
+  /** @brief Records that an update at `timestamp` was applied. */
+  inline void on_update(long long timestamp) noexcept {
+    if (!dirty_ && cadence_ > 0) {
+      next_emit_ = (timestamp / cadence_ + 1) * cadence_;
+    }
+    book_timestamp_ = timestamp;
+    dirty_ = true;
+  }
+
+  /** @brief Records that the book was published. */
+  inline void on_publish() noexcept { dirty_ = false; }
+
+  /** @brief Returns true if the book changed since the last snapshot. */
+  inline bool dirty() const noexcept { return dirty_; }
+
+  /** @brief Returns timestamp of the last applied update. */
+  inline long long book_timestamp() const noexcept { return book_timestamp_; }
+
+private:
+  long long cadence_;           ///< Minimum time between snapshots.
+  bool dirty_{false};           ///< Book changed since the last snapshot.
+  long long book_timestamp_{0}; ///< Timestamp of the last applied update.
+  long long next_emit_{0};      ///< Earliest timestamp of the next snapshot.
+};
+
+} // namespace data_loading
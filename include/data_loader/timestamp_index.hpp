@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace data_loading {
+
+/**
+ * @brief Sparse timestamp index of a LOB CSV file.
+ *
+ * Stores the timestamp and byte offset of every `stride`-th row, so a reader
+ * can jump close to any point in time and scan at most `stride` rows instead
+ * of the whole file. The index lives next to the data file (`<file>.idx`)
+ * and assumes rows are sorted by timestamp.
+ *
+ * Index file layout (native byte order):
+ *   uint32 magic, version, stride, reserved
+ *   uint64 entry count, size of the indexed file
+ *   {int64 timestamp, uint64 offset}[count]
+ */
+class TimestampIndex {
+public:
+  /// Default number of rows between two index entries.
+  static constexpr std::size_t DEFAULT_STRIDE = 4096;
+
+  /// @brief Indexed row.
+  struct Entry {
+    std::int64_t timestamp; ///< Timestamp of the row.
+    std::uint64_t offset;   ///< Byte offset of the row in the file.
+  };
+
+  /// @brief Constructs an empty index.
+  TimestampIndex() = default;
+
+  /**
+   * @brief Scans a LOB or trades CSV file and indexes every `stride`-th row.
+   *
+   * @param filename Path to an uncompressed LOB or trades CSV file.
+   * @param stride Number of rows between two entries.
+   * @return TimestampIndex Built index.
+   *
+   * @throws std::runtime_error If the file is compressed, cannot be read or
+   * is not sorted by timestamp.
+   */
+  static TimestampIndex build(const std::string &filename,
+                              std::size_t stride = DEFAULT_STRIDE);
+
+  /**
+   * @brief Reads an index written by save().
+   *
+   * @param index_filename Path to the index file.
+   * @return TimestampIndex Loaded index.
+   *
+   * @throws std::runtime_error If the file is missing or malformed.
+   */
+  static TimestampIndex load(const std::string &index_filename);
+
+  /**
+   * @brief Writes the index to a file.
+   *
+   * @param index_filename Output path.
+   *
+   * @throws std::runtime_error If the file cannot be written.
+   */
+  void save(const std::string &index_filename) const;
+
+  /** @brief Returns the conventional index path of a data file. */
+  static inline std::string path_for(const std::string &filename) {
+    return filename + ".idx";
+  }
+
+  /**
+   * @brief Checks that the index was built from the file as it is now.
+   *
+   * @param filename Path to the indexed data file.
+   * @return true If the file size matches the indexed size.
+   */
+  bool matches(const std::string &filename) const;
+
+  /**
+   * @brief Returns the offset to start scanning from to find `timestamp`.
+   *
+   * The first row with a timestamp at or after `timestamp` lies at or after
+   * the returned offset, at most `stride` rows further.
+   *
+   * @param timestamp Timestamp to look for.
+   * @return std::uint64_t Byte offset of a row start.
+   */
+  std::uint64_t offset_before(long long timestamp) const noexcept;
+
+  /** @brief Returns true if the index holds no entries. */
+  inline bool empty() const noexcept { return entries_.empty(); }
+
+  /** @brief Returns number of index entries. */
+  inline std::size_t size() const noexcept { return entries_.size(); }
+
+  /** @brief Returns number of rows between two entries. */
+  inline std::size_t stride() const noexcept { return stride_; }
+
+private:
+  std::size_t stride_{DEFAULT_STRIDE}; ///< Rows between two entries.
+  std::uint64_t data_size_{0};         ///< Size of the indexed file.
+  std::vector<Entry> entries_;         ///< Entries sorted by timestamp.
+};
+
+} // namespace data_loading
@@ -0,0 +1,156 @@
+#pragma once
+
+#include "data_loader/binary_format.hpp"
+#include "data_loader/csv_cursor.hpp"
+#include "data_loader/line_reader.hpp"
+#include "types.hpp"
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace data_loading {
+
+/**
+ * @brief Abstract pull-based source of market trade prints.
+ *
+ * Counterpart of MarketDataSource for trades: the engine pulls one trade at
+ * a time and merges it with the snapshot feed by timestamp.
+ */
+class TradeDataSource {
+public:
+  /// Unique pointer alias for convenience.
+  using UPtr = std::unique_ptr<TradeDataSource>;
+
+  /// Virtual destructor for proper cleanup in derived classes.
+  virtual ~TradeDataSource() = default;
+
+  /**
+   * @brief Advances to the next trade.
+   *
+   * @return const raw_data::TradeData* Pointer to the next trade, valid until
+   * the following call, or nullptr when the source is exhausted.
+   */
+  virtual const raw_data::TradeData *next() = 0;
+
+  /**
+   * @brief Moves to the first trade at or after `timestamp`.
+   *
+   * Same contract as MarketDataSource::seek().
+   *
+   * @param timestamp Timestamp to move to.
+   * @return true If the source moved.
+   * @return false If the source cannot seek; it is left untouched.
+   */
+  virtual bool seek(long long /*timestamp*/) { return false; }
+};
+
+/**
+ * @brief Trade source over an in-memory vector of trades.
+ */
+class InMemoryTradeSource final : public TradeDataSource {
+public:
+  /**
+   * @brief Constructs the source taking ownership of the trades.
+   *
+   * @param trades Trades sorted by timestamp.
+   */
+  explicit InMemoryTradeSource(std::vector<raw_data::TradeData> trades);
+
+  /**
+   * @brief Constructs the source over shared read-only trades.
+   *
+   * @param trades Trades sorted by timestamp.
+   */
+  explicit InMemoryTradeSource(
+      std::shared_ptr<const std::vector<raw_data::TradeData>> trades);
+
+  const raw_data::TradeData *next() override;
+
+  /** @brief Binary searches the trades for `timestamp`. */
+  bool seek(long long timestamp) override;
+
+private:
+  std::shared_ptr<const std::vector<raw_data::TradeData>> data_; ///< Trades.
+  std::size_t cursor_{0}; ///< Index of the next trade.
+};
+
+/**
+ * @brief Trade source streaming a trades CSV file.
+ *
+ * Uses a TimestampIndex found next to the file (`<file>.idx`) to seek, and
+ * scans timestamps otherwise.
+ */
+class CSVTradeSource final : public TradeDataSource {
+public:
+  /**
+   * @brief Opens a trades CSV file and skips its header.
+   *
+   * @param filename Path to the trades CSV file.
+   * @param buffer_size Size of the read-ahead buffer in bytes.
+   * @param scale Scale prices and amounts are converted to.
+   *
+   * @throws std::runtime_error If the file cannot be opened.
+   */
+  explicit CSVTradeSource(
+      const std::string &filename,
+      std::size_t buffer_size = LineReader::DEFAULT_BUFFER_SIZE,
+      const common_types::InstrumentScale &scale = {});
+
+  const raw_data::TradeData *next() override;
+
+  bool seek(long long timestamp) override;
+
+private:
+  /// Returns the row parser handed to the cursor.
+  inline auto parser() const noexcept {
+    return [this](std::string_view line, raw_data::TradeData &trade) {
+      return line_parsers::parse_trade_line(line, scale_, trade);
+    };
+  }
+
+private:
+  CSVCursor cursor_;                    ///< Rows of the file.
+  common_types::InstrumentScale scale_; ///< Scale of prices and amounts.
+  raw_data::TradeData current_{};       ///< Trade returned by next().
+};
+
+/**
+ * @brief Trade source reading a memory-mapped binary trades file.
+ */
+class BinaryTradeSource final : public TradeDataSource {
+public:
+  /**
+   * @brief Constructs the source over an opened binary trades file.
+   *
+   * @param trades_file Shared pointer to the mapped file.
+   */
+  explicit BinaryTradeSource(
+      std::shared_ptr<const BinaryTradesFile> trades_file);
+
+  const raw_data::TradeData *next() override;
+
+  /** @brief Binary searches the timestamp column for `timestamp`. */
+  bool seek(long long timestamp) override;
+
+private:
+  std::shared_ptr<const BinaryTradesFile> file_; ///< Mapped binary file.
+  std::size_t cursor_{0};                        ///< Index of the next row.
+  raw_data::TradeData current_{}; ///< Trade returned by the last next().
+};
+
+/**
+ * @brief Factory function to create a unique pointer to a given source type.
+ *
+ * @tparam SourceT Concrete trade source class.
+ * @param args Arguments forwarded to the source constructor.
+ * @return UPtr Unique pointer to the created source.
+ */
+template <typename SourceT, typename... Args>
+TradeDataSource::UPtr create_trade_source(Args &&...args) {
+  return std::make_unique<SourceT>(std::forward<Args>(args)...);
+}
+
+} // namespace data_loading
@@ -1,8 +1,17 @@
 #pragma once
 
+#include "data_loader/binary_format.hpp"
+#include "data_loader/event_stream.hpp"
+#include "data_loader/market_data_source.hpp"
+#include "data_loader/trade_data_source.hpp"
 #include "execution/market_engine.hpp"
+#include "execution/strategy_lane.hpp"
+#include "logging.hpp"
 #include "vaults/portfolio.hpp"
 #include "vaults/strategies.hpp"
+#include <limits>
+#include <memory>
+#include <type_traits>
 #include <vector>
 
 namespace execution {
@@ -10,11 +19,21 @@ namespace execution {
 /**
  * @brief Engine for backtesting trading strategies over historical LOB data.
  *
- * This class simulates a trading environment by feeding LOB snapshots
- * into a user-defined strategy and updating the portfolio based on executed
- * orders.
+ * This class simulates a trading environment by feeding LOB snapshots (and,
+ * optionally, market trades merged with them by timestamp) into a
+ * user-defined strategy and updating the portfolio based on executed orders.
+ *
+ * The strategy type is bound at compile time. BacktestEngine binds
+ * vault::StrategyBase and calls any strategy through its virtual methods;
+ * binding a concrete `final` strategy class instead lets the compiler call
+ * and inline its on_tick() directly in the replay loop.
+ *
+ * @tparam Strategy vault::StrategyBase or a class derived from it.
  */
-class BacktestEngine {
+template <class Strategy> class BasicBacktestEngine {
+  static_assert(std::is_base_of_v<vault::StrategyBase, Strategy>,
+                "Strategy must derive from vault::StrategyBase");
+
 public:
   /**
    * @brief Links a portfolio to the backtest engine.
@@ -25,50 +44,259 @@ public:
    * @param portfolio Shared pointer to a Portfolio instance.
    */
   inline void link_portfolio(vault::Portfolio::SPtr &portfolio) {
-    portfolio_ = portfolio;
+    lane_.set_portfolio(portfolio);
   }
 
   /**
    * @brief Sets the historical LOB data for the backtest.
    *
+   * The snapshots are copied; pass an rvalue to move them in instead.
+   *
    * @param lob_data Vector of LOB snapshots (raw_data::LOBData).
    */
-  inline void add_data(const std::vector<raw_data::LOBData> &lob_data) {
-    data_ = lob_data;
+  inline void add_data(std::vector<raw_data::LOBData> lob_data) {
+    set_data_source(
+        data_loading::create_data_source<data_loading::InMemoryDataSource>(
+            std::move(lob_data)));
+  }
+
+  /**
+   * @brief Sets a memory-mapped binary LOB file as the backtest data.
+   *
+   * Snapshots are read straight from the mapping on every tick, no parse
+   * step and no in-memory copy of the dataset is needed.
+   *
+   * @param lob_file Shared pointer to an opened BinaryLOBFile.
+   */
+  inline void
+  add_data(std::shared_ptr<const data_loading::BinaryLOBFile> lob_file) {
+    set_data_source(
+        data_loading::create_data_source<data_loading::BinaryDataSource>(
+            std::move(lob_file)));
+  }
+
+  /**
+   * @brief Sets the source the backtest pulls LOB snapshots from.
+   *
+   * `run()` reads one snapshot at a time, so streaming sources keep memory
+   * bounded regardless of the dataset length.
+   *
+   * @param source Unique pointer to a MarketDataSource instance.
+   */
+  inline void set_data_source(data_loading::MarketDataSource::UPtr &&source) {
+    data_source_ = std::move(source);
+    read_ = false;
+  }
+
+  /**
+   * @brief Sets market trades merged into the backtest feed.
+   *
+   * Trades and snapshots are replayed as one stream ordered by timestamp
+   * and every trade is passed to the strategy's `on_market_trade()`.
+   *
+   * @param trades Vector of trades sorted by timestamp.
+   */
+  inline void add_trades(std::vector<raw_data::TradeData> trades) {
+    set_trade_source(
+        data_loading::create_trade_source<data_loading::InMemoryTradeSource>(
+            std::move(trades)));
+  }
+
+  /**
+   * @brief Sets the source the backtest pulls market trades from.
+   *
+   * Without a trade source only LOB snapshots are replayed.
+   *
+   * @param source Unique pointer to a TradeDataSource instance.
+   */
+  inline void set_trade_source(data_loading::TradeDataSource::UPtr &&source) {
+    trade_source_ = std::move(source);
+    read_ = false;
   }
 
   /**
    * @brief Assigns a trading strategy to the backtest engine.
    *
-   * The engine will call `on_tick()` of the strategy for each LOB snapshot.
+   * The engine will call `on_tick()` of the strategy for each LOB snapshot
+   * and report fills and rejections of its orders to it.
+   *
+   * @param p_strategy Unique pointer to a Strategy instance.
+   */
+  inline void set_strategy(std::unique_ptr<Strategy> &&p_strategy) {
+    lane_.set_strategy(std::move(p_strategy));
+  }
+
+  /**
+   * @brief Sets the fixed-point scale of the backtested instrument.
+   *
+   * The scale is passed to the portfolio and the strategy when the backtest
+   * starts; it must match the scale the data was loaded with.
+   *
+   * @param scale Instrument scale.
+   */
+  inline void set_instrument_scale(const common_types::InstrumentScale &scale) {
+    scale_ = scale;
+  }
+
+  /**
+   * @brief Delays orders between the strategy and the book.
+   *
+   * An order submitted on an event reaches the book at the first snapshot
+   * at or after the event timestamp plus the sampled latency.
+   *
+   * @param model Latency model, or nullptr for none (the default).
+   */
+  inline void set_submit_latency(LatencyModel::UPtr &&model) noexcept {
+    lane_.exec_engine().set_submit_latency(std::move(model));
+  }
+
+  /**
+   * @brief Delays fill and rejection callbacks to the strategy.
    *
-   * @param p_strategy Unique pointer to a StrategyBase instance.
+   * @param model Latency model, or nullptr for none (the default).
    */
-  inline void set_strategy(vault::StrategyBase::UPtr &&p_strategy) {
-    p_strategy_ = std::move(p_strategy);
+  inline void set_ack_latency(LatencyModel::UPtr &&model) noexcept {
+    lane_.exec_engine().set_ack_latency(std::move(model));
   }
 
   /**
-   * @brief Runs the backtest over all loaded LOB data.
+   * @brief Runs the backtest over all snapshots of the data source.
    *
    * @return true If the backtest completed successfully.
-   * @return false If no strategy was set, LOB data is invalid, or an early exit
-   * occurred.
+   * @return false If no strategy or data source was set, LOB data is invalid,
+   * or an early exit occurred.
    */
   bool run();
 
+  /**
+   * @brief Runs the backtest over snapshots with timestamps in
+   * [from_ts, to_ts).
+   *
+   * The data source seeks straight to the first snapshot at or after
+   * `from_ts` (sources that cannot seek are skipped through instead) and the
+   * run stops at the first snapshot at or after `to_ts`. Several windows can
+   * be run one after another on the same loaded data: every run after the
+   * first seeks the sources, so they must support seek() to run again.
+   *
+   * @param from_ts First timestamp to include.
+   * @param to_ts First timestamp to exclude.
+   * @return true If the backtest completed successfully.
+   * @return false If no strategy or data source was set, LOB data is invalid,
+   * a source already read cannot seek, or an early exit occurred.
+   */
+  bool run(long long from_ts, long long to_ts);
+
 private:
-  /// The market simulation engine responsible for executing orders.
-  MarketEngine exec_engine_;
+  /// The strategy under test with its portfolio and execution state.
+  BasicStrategyLane<Strategy> lane_;
+
+  /// Source of historical LOB snapshots used for backtesting.
+  data_loading::MarketDataSource::UPtr data_source_;
 
-  /// Shared pointer to the portfolio being managed in the backtest.
-  vault::Portfolio::SPtr portfolio_;
+  /// Optional source of market trades merged with the snapshots.
+  data_loading::TradeDataSource::UPtr trade_source_;
 
-  /// Unique pointer to the trading strategy being tested.
-  vault::StrategyBase::UPtr p_strategy_;
+  /// Fixed-point scale of prices and amounts in the data.
+  common_types::InstrumentScale scale_;
 
-  /// Historical LOB data used for backtesting.
-  std::vector<raw_data::LOBData> data_;
+  /// The sources were read by a run and must be rewound for the next one.
+  bool read_{false};
 };
 
+/// Backtest engine calling strategies through the StrategyBase interface.
+using BacktestEngine = BasicBacktestEngine<vault::StrategyBase>;
+
+template <class Strategy> bool BasicBacktestEngine<Strategy>::run() {
+  return run(std::numeric_limits<long long>::min(),
+             std::numeric_limits<long long>::max());
+}
+
+template <class Strategy>
+bool BasicBacktestEngine<Strategy>::run(long long from_ts, long long to_ts) {
+  if (!lane_.ready()) {
+    logging::Logger::debug("[BACKTEST] No strategy or portfolio set.");
+    return false;
+  }
+
+  if (data_source_ == nullptr) {
+    logging::Logger::debug("[BACKTEST] No data source set.");
+    return false;
+  }
+
+  logging::Logger::debug("[BACKTEST] Starting backtest.\n");
+
+  lane_.set_scale(scale_);
+
+  data_loading::EventStream stream;
+  stream.add_source(
+      data_loading::create_event_source<data_loading::SnapshotEventSource>(
+          *data_source_));
+  if (trade_source_ != nullptr) {
+    stream.add_source(
+        data_loading::create_event_source<data_loading::TradeEventSource>(
+            *trade_source_));
+  }
+
+  // A fresh source starting from the beginning needs no seek.
+  if ((read_ || from_ts != std::numeric_limits<long long>::min()) &&
+      !stream.seek(from_ts)) {
+    if (read_) {
+      logging::Logger::debug("[BACKTEST] Source cannot seek, already read.");
+      return false;
+    }
+    logging::Logger::debug("[BACKTEST] Source cannot seek, skipping to ",
+                           from_ts);
+  }
+  read_ = true;
+
+  // Latest snapshot, kept for orders placed on trades. A source reusing its
+  // buffer has already moved on when a trade is merged in, so its snapshots
+  // are copied; others are only pointed to.
+  const bool copy_book =
+      trade_source_ != nullptr && !data_source_->retains_snapshots();
+  raw_data::LOBData book_copy;
+  const raw_data::LOBData *book{nullptr};
+  // Derived values of the current snapshot, shared with the strategy and
+  // the executors.
+  BookFeatures features(scale_);
+
+  size_t i{0};
+  while (const data_loading::MarketEvent *event = stream.next()) {
+    if (event->local_timestamp < from_ts) {
+      continue;
+    }
+    if (event->local_timestamp >= to_ts) {
+      break;
+    }
+
+    if (event->type == data_loading::EventType::Trade) {
+      logging::Logger::debug("[BACKTEST] Trade ts=", event->local_timestamp);
+      lane_.on_trade(*event->trade, event->local_timestamp,
+                     book != nullptr ? &features : nullptr);
+      continue;
+    }
+
+    const raw_data::LOBData &data = *event->snapshot;
+    logging::Logger::debug("[BACKTEST] Tick #", i++,
+                           " ts=", data.local_timestamp);
+    // The strategy sees the snapshot without a copy, or the kept copy, which
+    // stays valid for on_market_trade().
+    book = &data;
+    if (copy_book) {
+      book_copy = data;
+      book = &book_copy;
+    }
+    features.reset(*book);
+    if (!lane_.on_snapshot(*book, features)) {
+      return false;
+    }
+
+    logging::Logger::debug("------------");
+  }
+
+  return true;
+}
+
+extern template class BasicBacktestEngine<vault::StrategyBase>;
+
 } // namespace execution
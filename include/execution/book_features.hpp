@@ -0,0 +1,163 @@
+#pragma once
+
+#include "types.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace execution {
+
+/**
+ * @brief Derived values of one LOB snapshot, computed on first access.
+ *
+ * The engine binds one instance to every snapshot and hands it to the
+ * executors and the strategy, so best prices, mid, spread, microprice and
+ * the cumulative depth of each side are computed at most once per snapshot
+ * whoever asks first. Prices returned as double are in instrument units;
+ * depths are raw common_types::Amount values.
+ *
+ * The cache is not thread-safe and the bound snapshot must outlive it or the
+ * next reset().
+ */
+class BookFeatures {
+public:
+  /**
+   * @brief Constructs features bound to an empty book.
+   *
+   * @param scale Scale used to convert prices and amounts to doubles.
+   */
+  explicit BookFeatures(const common_types::InstrumentScale &scale = {});
+
+  /**
+   * @brief Constructs features bound to a snapshot.
+   *
+   * @param data Snapshot to describe.
+   * @param scale Scale used to convert prices and amounts to doubles.
+   */
+  explicit BookFeatures(const raw_data::LOBData &data,
+                        const common_types::InstrumentScale &scale = {});
+
+  /**
+   * @brief Binds a new snapshot and drops every cached value.
+   *
+   * @param data Snapshot to describe.
+   */
+  inline void reset(const raw_data::LOBData &data) noexcept {
+    data_ = &data;
+    valid_ = 0;
+  }
+
+  /** @brief Sets the scale used by the double accessors. */
+  inline void set_scale(const common_types::InstrumentScale &scale) noexcept {
+    scale_ = scale;
+    valid_ &= static_cast<std::uint8_t>(~TOP);
+  }
+
+  /** @brief Returns the bound snapshot. */
+  inline const raw_data::LOBData &data() const noexcept { return *data_; }
+
+  /** @brief Returns the side an order of side `taker` walks: asks for Buy. */
+  inline const raw_data::BookSide &
+  book_side(common_types::Side taker) const noexcept {
+    return taker == common_types::Side::Buy ? data_->asks : data_->bids;
+  }
+
+  /** @brief Returns true if both sides have at least one level. */
+  inline bool two_sided() const noexcept {
+    return !data_->bids.empty() && !data_->asks.empty();
+  }
+
+  /** @brief Returns the best bid, or 0 if there are no bids. */
+  inline double best_bid() const noexcept { return top().best_bid; }
+
+  /** @brief Returns the best ask, or 0 if there are no asks. */
+  inline double best_ask() const noexcept { return top().best_ask; }
+
+  /** @brief Returns (best bid + best ask) / 2. */
+  inline double mid() const noexcept { return top().mid; }
+
+  /** @brief Returns best ask - best bid, or 0 unless two-sided. */
+  inline double spread() const noexcept { return top().spread; }
+
+  /**
+   * @brief Returns the top-of-book price weighted by the opposite amount.
+   *
+   * (bid * ask amount + ask * bid amount) / (bid amount + ask amount); the
+   * mid when the book is not two-sided.
+   */
+  inline double microprice() const noexcept { return top().microprice; }
+
+  /**
+   * @brief Returns the amount resting in the first `levels` ask levels.
+   *
+   * @param levels Number of levels; larger values are clamped.
+   */
+  common_types::Amount ask_depth(std::size_t levels) const noexcept;
+
+  /**
+   * @brief Returns the amount resting in the first `levels` bid levels.
+   *
+   * @param levels Number of levels; larger values are clamped.
+   */
+  common_types::Amount bid_depth(std::size_t levels) const noexcept;
+
+  /**
+   * @brief Returns the order book imbalance over the first `levels` levels.
+   *
+   * @return double (bid depth - ask depth) / (bid depth + ask depth), in
+   * [-1, 1], or 0 if both are empty.
+   */
+  double imbalance(std::size_t levels) const noexcept;
+
+  /**
+   * @brief Counts the leading levels of book_side(taker) within `limit`.
+   *
+   * @see kernels::levels_within
+   */
+  std::size_t levels_within(common_types::Price limit,
+                            common_types::Side taker) const noexcept;
+
+  /**
+   * @brief Finds the level of book_side(taker) where `amount` is exhausted.
+   *
+   * Searches the cached depth prefix sums when they were already computed,
+   * otherwise scans the side with the vector kernel.
+   *
+   * @see kernels::exhaust_level
+   */
+  std::size_t exhaust_level(common_types::Side taker, std::size_t levels,
+                            common_types::Amount amount) const noexcept;
+
+private:
+  /// Cached value groups.
+  enum : std::uint8_t { TOP = 1, ASK_DEPTH = 2, BID_DEPTH = 4 };
+
+  /// @brief Top-of-book values, computed together.
+  struct Top {
+    double best_bid;   ///< Best bid.
+    double best_ask;   ///< Best ask.
+    double mid;        ///< Mid price.
+    double spread;     ///< Ask - bid.
+    double microprice; ///< Amount-weighted top price.
+  };
+
+  /// Cumulative amounts: element i holds the sum of the first i levels.
+  using Prefix = std::array<common_types::Amount, raw_data::MAX_LOB_DEPTH + 1>;
+
+  /// Returns the top-of-book group, computing it on first use.
+  const Top &top() const noexcept;
+
+  /// Returns the prefix sums of one side, computing them on first use.
+  const Prefix &prefix(const raw_data::BookSide &side, Prefix &sums,
+                       std::uint8_t flag) const noexcept;
+
+private:
+  const raw_data::LOBData *data_;       ///< Bound snapshot.
+  common_types::InstrumentScale scale_; ///< Scale of the double accessors.
+  mutable std::uint8_t valid_{0};       ///< Groups computed for data_.
+  mutable Top top_{};                   ///< Top-of-book values.
+  mutable Prefix ask_prefix_;           ///< Ask depth prefix sums.
+  mutable Prefix bid_prefix_;           ///< Bid depth prefix sums.
+};
+
+} // namespace execution
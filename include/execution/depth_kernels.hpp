@@ -0,0 +1,83 @@
+#pragma once
+
+#include "types.hpp"
+#include <cstddef>
+
+/**
+ * @brief Vectorized queries over one side of a LOB snapshot.
+ *
+ * The kernels scan the price and amount columns of a raw_data::BookSide with
+ * AVX2 when the library is built with it (HFT_TASK_AVX2), otherwise with
+ * SSE2 on x86-64, and fall back to plain loops elsewhere. The fixed-point
+ * kernels need SSE4.2 (HFT_TASK_SSE42) and are plain loops with SSE2 only.
+ * Levels are taken in book order, best first; the "taker" side is the side
+ * of the order walking the book, so a Buy walks the asks and a Sell the
+ * bids.
+ *
+ * Integer (fixed-point) results are exact. In the floating-point build the
+ * vector kernels may add amounts in a different order than a sequential
+ * loop, so sums can differ from it in the last bits.
+ */
+namespace execution::kernels {
+
+/**
+ * @brief Counts the leading levels an order limited at `limit` may take.
+ *
+ * @param side Book side walked by the order.
+ * @param limit Worst acceptable price.
+ * @param taker Buy (levels priced at or below `limit`) or Sell (at or
+ * above).
+ * @return std::size_t Index of the first level beyond the limit, or
+ * side.size().
+ */
+std::size_t levels_within(const raw_data::BookSide &side,
+                          common_types::Price limit,
+                          common_types::Side taker) noexcept;
+
+/**
+ * @brief Sums the amounts of the first `levels` levels.
+ *
+ * @param side Book side.
+ * @param levels Number of levels, at most side.size().
+ */
+common_types::Amount cumulative_depth(const raw_data::BookSide &side,
+                                      std::size_t levels) noexcept;
+
+/**
+ * @brief Returns the amount available up to a limit price.
+ *
+ * @param side Book side walked by the order.
+ * @param limit Worst acceptable price.
+ * @param taker Side of the order walking the book.
+ */
+inline common_types::Amount depth_within(const raw_data::BookSide &side,
+                                         common_types::Price limit,
+                                         common_types::Side taker) noexcept {
+  return cumulative_depth(side, levels_within(side, limit, taker));
+}
+
+/**
+ * @brief Finds the level at which `amount` is exhausted.
+ *
+ * @param side Book side.
+ * @param levels Number of leading levels to consider, at most side.size().
+ * @param amount Amount to take.
+ * @return std::size_t Smallest index whose cumulative amount reaches
+ * `amount`, or `levels` if the levels do not hold enough.
+ */
+std::size_t exhaust_level(const raw_data::BookSide &side, std::size_t levels,
+                          common_types::Amount amount) noexcept;
+
+/**
+ * @brief Computes the volume-weighted price of taking `amount`.
+ *
+ * @param side Book side walked by the order.
+ * @param amount Amount to take.
+ * @param filled Output amount actually available, at most `amount`.
+ * @return double Average price of the `filled` amount, in the unit of
+ * common_types::Price, or 0 if nothing is available.
+ */
+double vwap(const raw_data::BookSide &side, common_types::Amount amount,
+            common_types::Amount &filled) noexcept;
+
+} // namespace execution::kernels
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "types.hpp"
+#include <span>
+
+namespace execution {
+
+/**
+ * @brief Receives the outcome of every execution attempt of a MarketEngine.
+ *
+ * The engine calls the listener inline, from tick(), with references to its
+ * own order and fill storage; they are only valid during the call.
+ */
+class ExecutionListener {
+public:
+  /// @brief Virtual destructor.
+  virtual ~ExecutionListener() = default;
+
+  /**
+   * @brief Called when an order was executed and booked in the portfolio.
+   *
+   * @param order Executed order, with the id it was submitted under.
+   * @param fills Fills of the order, best price first.
+   */
+  virtual void on_fill(const common_types::Order & /*order*/,
+                       std::span<const common_types::ExecutionFill> /*fills*/) {
+  }
+
+  /**
+   * @brief Called when an execution attempt of an order failed.
+   *
+   * The order stays pending and is attempted again on the next tick, so
+   * this is called once per failed attempt.
+   *
+   * @param order Rejected order.
+   * @param reason Why the order could not be executed.
+   */
+  virtual void on_order_rejected(const common_types::Order & /*order*/,
+                                 common_types::RejectReason /*reason*/) {}
+};
+
+} // namespace execution
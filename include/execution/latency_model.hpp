@@ -0,0 +1,94 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <utility>
+
+namespace execution {
+
+/**
+ * @brief Source of the delays of orders and acknowledgements.
+ *
+ * Latencies are in the units of the data timestamps.
+ */
+class LatencyModel {
+public:
+  using UPtr = std::unique_ptr<LatencyModel>;
+
+  virtual ~LatencyModel() = default;
+
+  /** @brief Returns the latency of the next message, never negative. */
+  virtual long long sample() = 0;
+};
+
+/// @brief Same latency for every message.
+class FixedLatency final : public LatencyModel {
+public:
+  /**
+   * @brief Constructs the model.
+   *
+   * @param latency Latency of every message.
+   *
+   * @throws std::invalid_argument If latency is negative.
+   */
+  explicit FixedLatency(long long latency) : latency_(latency) {
+    if (latency < 0) {
+      throw std::invalid_argument("Latency must not be negative");
+    }
+  }
+
+  inline long long sample() override { return latency_; }
+
+private:
+  long long latency_; ///< Latency of every message.
+};
+
+/**
+ * @brief Latency drawn from a random distribution.
+ *
+ * Samples are rounded to the nearest timestamp unit and negative ones are
+ * clamped to 0. The generator is seeded explicitly, so a backtest is
+ * reproducible.
+ *
+ * @tparam Distribution A standard random number distribution, e.g.
+ * std::lognormal_distribution<double>.
+ */
+template <class Distribution> class SampledLatency final : public LatencyModel {
+public:
+  /**
+   * @brief Constructs the model.
+   *
+   * @param distribution Distribution of the latency.
+   * @param seed Seed of the generator.
+   */
+  explicit SampledLatency(Distribution distribution, std::uint64_t seed = 0)
+      : distribution_(std::move(distribution)), generator_(seed) {}
+
+  inline long long sample() override {
+    const double latency = static_cast<double>(distribution_(generator_));
+    return std::max(0LL, std::llround(latency));
+  }
+
+private:
+  Distribution distribution_; ///< Distribution of the latency.
+  std::mt19937_64 generator_; ///< Random generator.
+};
+
+/**
+ * @brief Factory function to create a unique pointer to a given model type.
+ *
+ * @tparam LatencyModelT Type of the model to create.
+ * @tparam Args Types of the constructor arguments.
+ * @param args Arguments forwarded to the LatencyModelT constructor.
+ * @return LatencyModel::UPtr Unique pointer to the created model.
+ */
+template <typename LatencyModelT, typename... Args>
+LatencyModel::UPtr create_latency_model(Args &&...args) {
+  return std::make_unique<LatencyModelT>(std::forward<Args>(args)...);
+}
+
+} // namespace execution
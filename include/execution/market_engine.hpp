@@ -1,8 +1,15 @@
 #pragma once
 
+#include "execution/book_features.hpp"
+#include "execution/execution_listener.hpp"
+#include "execution/latency_model.hpp"
 #include "execution/orders.hpp"
+#include "execution/resting_orders.hpp"
 #include "types.hpp"
 #include "vaults/portfolio.hpp"
+#include <cstdint>
+#include <limits>
+#include <span>
 #include <unordered_map>
 #include <vector>
 
@@ -13,9 +20,23 @@ namespace execution {
  *
  * The MarketEngine maintains a pool of pending orders, executes them according
  * to their type and current LOB data, and updates the portfolio accordingly.
+ * LimitGtc and PostOnly orders that do not fill on arrival rest in a
+ * RestingOrderBook until the market trades with them or they are cancelled.
+ *
+ * Without latency models an order reaches the book at the next tick and
+ * its fills are reported at once. With a submission latency, orders and
+ * cancellations submitted with a timestamp are in flight until their
+ * arrival time and reach the book at the first tick at or after it. With an
+ * acknowledgement latency, fills and rejections are reported when
+ * advance_to() passes their delivery time. In-flight orders and
+ * acknowledgements are kept in binary min-heaps, so each costs O(log n).
  */
 class MarketEngine {
 public:
+  /// First id the engine gives to orders submitted with id 0. Client ids
+  /// must stay below it, so the two can never collide.
+  static constexpr std::uint64_t FIRST_ENGINE_ORDER_ID = 1ULL << 63;
+
   /**
    * @brief Constructs a MarketEngine and initializes order execution policies.
    *
@@ -23,18 +44,111 @@ public:
    */
   MarketEngine();
 
+  /**
+   * @brief Sets the listener notified of fills and rejections.
+   *
+   * @param listener Listener called inline from tick(), or nullptr; not
+   * owned, must outlive its registration.
+   */
+  inline void set_listener(ExecutionListener *listener) noexcept {
+    listener_ = listener;
+  }
+
+  /**
+   * @brief Sets the delay between submitting an order and its arrival at
+   * the book.
+   *
+   * @param model Latency model, or nullptr for none.
+   */
+  inline void set_submit_latency(LatencyModel::UPtr &&model) noexcept {
+    submit_latency_ = std::move(model);
+  }
+
+  /**
+   * @brief Sets the delay between an order executing or being rejected and
+   * the listener being told.
+   *
+   * @param model Latency model, or nullptr for none.
+   */
+  inline void set_ack_latency(LatencyModel::UPtr &&model) noexcept {
+    ack_latency_ = std::move(model);
+  }
+
   /**
    * @brief Adds a new order to the pending order pool.
    *
-   * The order will be executed during the next tick based on LOB data.
+   * The order will be executed during the next tick based on LOB data. An
+   * order with id 0 is given the next engine-assigned id.
    *
    * @param order Order to be added.
    */
   void add_order(const common_types::Order &order);
 
+  /**
+   * @brief Adds a batch of orders to the pending order pool.
+   *
+   * The orders are executed in batch order during the next tick.
+   *
+   * @param orders Orders to be added.
+   */
+  void add_orders(std::span<const common_types::Order> orders);
+
+  /**
+   * @brief Submits an order at `timestamp`.
+   *
+   * Without a submission latency the order is added to the pending pool at
+   * once; otherwise it is in flight until timestamp plus the sampled
+   * latency. An order with id 0 is given the next engine-assigned id.
+   *
+   * @param order Order to submit.
+   * @param timestamp Submission time.
+   */
+  void add_order(const common_types::Order &order, long long timestamp);
+
+  /**
+   * @brief Submits a batch of orders at `timestamp`.
+   *
+   * @see add_order(const common_types::Order &, long long)
+   */
+  void add_orders(std::span<const common_types::Order> orders,
+                  long long timestamp);
+
+  /**
+   * @brief Submits an order between snapshots and processes it alone.
+   *
+   * Used for orders placed on market trades: the rest of the pending pool
+   * was already tried against `features` and is left for the next tick. An
+   * order still in flight is not processed.
+   *
+   * @param order Order to submit.
+   * @param timestamp Submission time.
+   * @param features Features bound to the latest LOB snapshot.
+   * @param portfolio Shared pointer to the portfolio to update.
+   * @return true If the order was executed.
+   */
+  bool submit_and_tick(const common_types::Order &order, long long timestamp,
+                       const BookFeatures &features,
+                       vault::Portfolio::SPtr &portfolio);
+
+  /**
+   * @brief Delivers the acknowledgements due by `timestamp` to the listener.
+   *
+   * Call at every event, before the strategy sees it. The engine clock
+   * never moves back.
+   *
+   * @param timestamp Current time.
+   */
+  void advance_to(long long timestamp);
+
+  /** @brief Returns number of orders and cancellations in flight. */
+  inline std::size_t in_flight() const noexcept { return in_flight_.size(); }
+
   /**
    * @brief Processes all pending orders against the given LOB snapshot.
    *
+   * Orders and cancellations in flight that arrived by the snapshot
+   * timestamp reach the book first.
+   *
    * @param data Current LOB snapshot.
    * @param portfolio Shared pointer to the portfolio to update.
    * @return true If at least one order was executed.
@@ -42,22 +156,162 @@ public:
    */
   bool tick(const raw_data::LOBData &data, vault::Portfolio::SPtr &portfolio);
 
+  /**
+   * @brief Processes all pending orders against a snapshot and its features.
+   *
+   * @param features Features bound to the current LOB snapshot, shared with
+   * the strategy.
+   * @param portfolio Shared pointer to the portfolio to update.
+   * @return true If at least one order was executed.
+   */
+  bool tick(const BookFeatures &features, vault::Portfolio::SPtr &portfolio);
+
+  /**
+   * @brief Advances the resting orders to a new snapshot.
+   *
+   * Call once per snapshot, before the strategy sees it. Orders the
+   * snapshot crossed are filled and settled.
+   *
+   * @param features Features bound to the new LOB snapshot.
+   * @param portfolio Shared pointer to the portfolio to update.
+   */
+  void update_resting(const BookFeatures &features,
+                      vault::Portfolio::SPtr &portfolio);
+
+  /**
+   * @brief Advances the resting orders with a market trade.
+   *
+   * Call for every trade, before the strategy sees it. Resting orders the
+   * trade reaches are filled and settled.
+   *
+   * @param trade Market trade.
+   * @param portfolio Shared pointer to the portfolio to update.
+   */
+  void on_market_trade(const raw_data::TradeData &trade,
+                       vault::Portfolio::SPtr &portfolio);
+
+  /**
+   * @brief Cancels a pending or resting order.
+   *
+   * @param id Order id.
+   * @return true If the order was found and removed.
+   */
+  bool cancel(std::uint64_t id);
+
+  /**
+   * @brief Submits the cancellation of an order at `timestamp`.
+   *
+   * Without a submission latency the order is cancelled at once; otherwise
+   * the request is in flight like an order, and has no effect if the order
+   * is not pending or resting when it arrives.
+   *
+   * @param id Order id.
+   * @param timestamp Submission time.
+   */
+  void cancel(std::uint64_t id, long long timestamp);
+
+  /** @brief Returns the resting orders. */
+  inline const RestingOrderBook &resting_orders() const noexcept {
+    return resting_;
+  }
+
   /**
    * @brief Executes a single order against the current LOB snapshot.
    *
    * @param order Order to execute.
    * @param data Current LOB snapshot.
    * @param portfolio Shared pointer to the portfolio to update.
+   * The listener, if any, is notified of the fills or of the rejection.
+   *
    * @return true If the order was successfully executed.
    * @return false If the order could not be executed (e.g., no fills or
    * insufficient portfolio).
    *
-   * @throws std::runtime_error If the order type is unsupported or the side is
-   * undefined.
+   * @throws std::runtime_error If the order type is unsupported (LimitGtc and
+   * PostOnly only go through tick()) or the side is undefined.
    */
   bool execute(const common_types::Order &order, const raw_data::LOBData &data,
                vault::Portfolio::SPtr &portfolio);
 
+  /**
+   * @brief Executes a single order against a snapshot and its features.
+   *
+   * @see execute(const common_types::Order &, const raw_data::LOBData &,
+   * vault::Portfolio::SPtr &)
+   */
+  bool execute(const common_types::Order &order, const BookFeatures &features,
+               vault::Portfolio::SPtr &portfolio);
+
+private:
+  /// Processes the pending orders from index `first` on.
+  bool process(const BookFeatures &features, vault::Portfolio::SPtr &portfolio,
+               std::size_t first);
+
+  /**
+   * @brief Places a LimitGtc or PostOnly order: executes the part that
+   * crosses, if allowed, and rests the remainder. An order whose id is
+   * already resting is rejected with DuplicateId.
+   *
+   * @return true If part of the order was executed.
+   */
+  bool place(const common_types::Order &order, const BookFeatures &features,
+             vault::Portfolio::SPtr &portfolio);
+
+  /**
+   * @brief Updates the portfolio with the fills of an order and notifies the
+   * listener.
+   *
+   * @return false If the portfolio cannot take the fills; the order is
+   * rejected.
+   */
+  bool settle(const common_types::Order &order,
+              const std::vector<common_types::ExecutionFill> &fills,
+              vault::Portfolio::SPtr &portfolio);
+
+  /// Settles resting_fills_; cancels the orders the portfolio cannot take.
+  void settle_resting(vault::Portfolio::SPtr &portfolio);
+
+  /// Gives `order` the next engine id if it was submitted with id 0.
+  inline void assign_id(common_types::Order &order) noexcept {
+    if (order.id == 0) {
+      order.id = FIRST_ENGINE_ORDER_ID + engine_ids_++;
+    }
+  }
+
+  /// Notifies the listener that `order` was rejected; returns false.
+  bool reject(const common_types::Order &order,
+              common_types::RejectReason reason);
+
+  /// Notifies the listener of the fills of `order`.
+  void report_fills(const common_types::Order &order,
+                    const std::vector<common_types::ExecutionFill> &fills);
+
+  /// Moves the orders and cancellations arrived by `timestamp` to the book.
+  void release(long long timestamp);
+
+  /// @brief Order or cancellation on its way to the book.
+  struct InFlight {
+    long long time;            ///< Arrival time.
+    std::uint64_t seq;         ///< Submission order, breaks ties.
+    common_types::Order order; ///< Order, or the id to cancel.
+    bool cancel;               ///< True for a cancellation.
+  };
+
+  /// @brief Fill or rejection on its way to the listener.
+  struct Ack {
+    long long time;                                 ///< Delivery time.
+    std::uint64_t seq;                              ///< Breaks ties.
+    common_types::Order order;                      ///< Order concerned.
+    std::vector<common_types::ExecutionFill> fills; ///< Empty if rejected.
+    common_types::RejectReason reason;              ///< Rejection reason.
+  };
+
+  /// Heap order: true if `lhs` is due after `rhs`.
+  template <class Event>
+  static inline bool later(const Event &lhs, const Event &rhs) noexcept {
+    return lhs.time != rhs.time ? lhs.time > rhs.time : lhs.seq > rhs.seq;
+  }
+
 private:
   /// Mapping of order types to their respective executor objects.
   using OrdersExecitonPolicy =
@@ -69,6 +323,39 @@ private:
 
   /// Pool of orders waiting to be executed.
   std::vector<common_types::Order> pending_orders_;
+
+  /// LimitGtc and PostOnly orders waiting in the queue of their level.
+  RestingOrderBook resting_;
+
+  /// Fills of resting orders of the current update.
+  std::vector<RestingOrderBook::Fill> resting_fills_;
+
+  /// One fill of a resting order, in the form the portfolio takes.
+  std::vector<common_types::ExecutionFill> resting_fill_;
+
+  /// Notified of fills and rejections, not owned.
+  ExecutionListener *listener_{nullptr};
+
+  /// Number of ids given to orders submitted without one.
+  std::uint64_t engine_ids_{0};
+
+  /// Delay of orders and cancellations, nullptr for none.
+  LatencyModel::UPtr submit_latency_;
+
+  /// Delay of fills and rejections, nullptr for none.
+  LatencyModel::UPtr ack_latency_;
+
+  /// Orders and cancellations in flight, earliest arrival on top.
+  std::vector<InFlight> in_flight_;
+
+  /// Acknowledgements not yet delivered, earliest on top.
+  std::vector<Ack> acks_;
+
+  /// Last sequence number given to an in-flight message.
+  std::uint64_t last_seq_{0};
+
+  /// Engine clock: latest time seen by advance_to() or tick().
+  long long now_{std::numeric_limits<long long>::min()};
 };
 
 } // namespace execution
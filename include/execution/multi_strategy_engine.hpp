@@ -0,0 +1,207 @@
+#pragma once
+
+#include "data_loader/event_stream.hpp"
+#include "data_loader/market_data_source.hpp"
+#include "data_loader/trade_data_source.hpp"
+#include "execution/book_features.hpp"
+#include "execution/market_engine.hpp"
+#include "execution/strategy_lane.hpp"
+#include "types.hpp"
+#include "vaults/portfolio.hpp"
+#include "vaults/strategies.hpp"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace execution {
+
+/**
+ * @brief Backtests several strategies in one pass over the data.
+ *
+ * Every strategy gets its own MarketEngine pending pool and Portfolio, like
+ * a separate BacktestEngine run, but all of them are fed from one shared
+ * cursor: each snapshot is read once and handed to every strategy while it
+ * is hot in cache, instead of streaming the whole dataset once per
+ * strategy.
+ *
+ * With several threads the strategies are split across them. The calling
+ * thread reads the next event and all threads meet at a barrier before and
+ * after processing it, so every strategy sees the same event sequence as in
+ * a serial run. Two barrier waits per event only pay off when the
+ * strategies do real work on every tick.
+ */
+class MultiStrategyEngine {
+public:
+  /**
+   * @brief Adds a strategy trading its own portfolio.
+   *
+   * @param p_strategy Unique pointer to a StrategyBase instance.
+   * @param portfolio Portfolio updated by the strategy's orders.
+   * @return std::size_t Index of the strategy, in the order of addition.
+   */
+  std::size_t add_strategy(vault::StrategyBase::UPtr &&p_strategy,
+                           const vault::Portfolio::SPtr &portfolio);
+
+  /**
+   * @brief Delays the orders of one strategy between it and the book.
+   *
+   * @param strategy Index returned by add_strategy().
+   * @param model Latency model, or nullptr for none (the default).
+   *
+   * @throws std::out_of_range If there is no such strategy.
+   *
+   * @see BacktestEngine::set_submit_latency
+   */
+  inline void set_submit_latency(std::size_t strategy,
+                                 LatencyModel::UPtr &&model) {
+    lanes_.at(strategy).exec_engine().set_submit_latency(std::move(model));
+  }
+
+  /**
+   * @brief Delays the fill and rejection callbacks of one strategy.
+   *
+   * @param strategy Index returned by add_strategy().
+   * @param model Latency model, or nullptr for none (the default).
+   *
+   * @throws std::out_of_range If there is no such strategy.
+   */
+  inline void set_ack_latency(std::size_t strategy,
+                              LatencyModel::UPtr &&model) {
+    lanes_.at(strategy).exec_engine().set_ack_latency(std::move(model));
+  }
+
+  /** @brief Returns number of strategies. */
+  inline std::size_t size() const noexcept { return lanes_.size(); }
+
+  /**
+   * @brief Sets the historical LOB data for the backtest.
+   *
+   * @param lob_data Vector of LOB snapshots (raw_data::LOBData).
+   */
+  inline void add_data(std::vector<raw_data::LOBData> lob_data) {
+    set_data_source(
+        data_loading::create_data_source<data_loading::InMemoryDataSource>(
+            std::move(lob_data)));
+  }
+
+  /**
+   * @brief Sets the source the backtest pulls LOB snapshots from.
+   *
+   * @param source Unique pointer to a MarketDataSource instance.
+   */
+  inline void set_data_source(data_loading::MarketDataSource::UPtr &&source) {
+    data_source_ = std::move(source);
+    read_ = false;
+  }
+
+  /**
+   * @brief Sets market trades merged into the backtest feed.
+   *
+   * @param trades Vector of trades sorted by timestamp.
+   */
+  inline void add_trades(std::vector<raw_data::TradeData> trades) {
+    set_trade_source(
+        data_loading::create_trade_source<data_loading::InMemoryTradeSource>(
+            std::move(trades)));
+  }
+
+  /**
+   * @brief Sets the source the backtest pulls market trades from.
+   *
+   * @param source Unique pointer to a TradeDataSource instance.
+   */
+  inline void set_trade_source(data_loading::TradeDataSource::UPtr &&source) {
+    trade_source_ = std::move(source);
+    read_ = false;
+  }
+
+  /** @brief Sets the fixed-point scale of the backtested instrument. */
+  inline void set_instrument_scale(const common_types::InstrumentScale &scale) {
+    scale_ = scale;
+  }
+
+  /**
+   * @brief Sets the number of threads the strategies are split across.
+   *
+   * @param threads Number of threads including the calling one; 0 means
+   * one per hardware thread. Never more than one per strategy is used.
+   */
+  inline void set_threads(std::size_t threads) noexcept { threads_ = threads; }
+
+  /**
+   * @brief Runs every strategy over all snapshots of the data source.
+   *
+   * @return true If the backtest completed successfully.
+   * @return false If no strategy or data source was set, LOB data is
+   * invalid, or an early exit occurred.
+   *
+   * @throws Rethrows the first exception raised by a strategy or the data,
+   * once every thread has stopped.
+   */
+  bool run();
+
+  /**
+   * @brief Runs every strategy over snapshots with timestamps in
+   * [from_ts, to_ts).
+   *
+   * @see BacktestEngine::run(long long, long long)
+   */
+  bool run(long long from_ts, long long to_ts);
+
+private:
+  /// @brief Event processed by all lanes, published by the reading thread.
+  struct Step {
+    const data_loading::MarketEvent *event{nullptr}; ///< Current event.
+    const raw_data::LOBData *book{nullptr}; ///< Latest snapshot, or nullptr.
+  };
+
+  /**
+   * @brief Reads the next event in [from_ts, to_ts) into `step`.
+   *
+   * @return false When the stream is exhausted or past `to_ts`.
+   */
+  bool advance(data_loading::EventStream &stream, long long from_ts,
+               long long to_ts, Step &step);
+
+  /**
+   * @brief Processes the current event for one lane.
+   *
+   * @param lane Lane to process.
+   * @param step Current event and latest snapshot.
+   * @param features Features of the calling thread, bound to step.book.
+   */
+  void process(StrategyLane &lane, const Step &step,
+               const BookFeatures &features);
+
+  /// Processes every event serially on the calling thread.
+  bool run_serial(data_loading::EventStream &stream, long long from_ts,
+                  long long to_ts);
+
+  /// Processes the events with the lanes split across `threads` threads.
+  bool run_parallel(data_loading::EventStream &stream, long long from_ts,
+                    long long to_ts, std::size_t threads);
+
+private:
+  /// Strategies with their execution state.
+  std::vector<StrategyLane> lanes_;
+
+  /// Source of historical LOB snapshots, shared by all strategies.
+  data_loading::MarketDataSource::UPtr data_source_;
+
+  /// Optional source of market trades merged with the snapshots.
+  data_loading::TradeDataSource::UPtr trade_source_;
+
+  /// Fixed-point scale of prices and amounts in the data.
+  common_types::InstrumentScale scale_;
+
+  /// The sources were read by a run and must be rewound for the next one.
+  bool read_{false};
+
+  /// Requested number of threads, 0 for one per hardware thread.
+  std::size_t threads_{1};
+
+  /// Copy of the latest snapshot, kept when trades are merged in.
+  raw_data::LOBData book_;
+};
+
+} // namespace execution
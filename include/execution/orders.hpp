@@ -1,5 +1,6 @@
 #pragma once
 
+#include "execution/book_features.hpp"
 #include "types.hpp"
 #include <memory>
 #include <vector>
@@ -27,18 +28,29 @@ public:
   execute_order(const common_types::Order &order,
                 const raw_data::LOBData &data);
 
+  /**
+   * @brief Executes an order against a snapshot and its cached features.
+   *
+   * @param order Order to execute.
+   * @param features Features bound to the current LOB snapshot.
+   * @return Vector of execution fills.
+   */
+  std::vector<common_types::ExecutionFill>
+  execute_order(const common_types::Order &order,
+                const BookFeatures &features);
+
   /**
    * @brief Executes a buy order.
    *
    * Must be implemented by derived classes.
    *
    * @param order Order to execute.
-   * @param data Current LOB snapshot.
+   * @param features Features bound to the current LOB snapshot.
    * @return Vector of execution fills.
    */
   virtual std::vector<common_types::ExecutionFill>
   execute_buy_order(const common_types::Order &order,
-                    const raw_data::LOBData &data) = 0;
+                    const BookFeatures &features) = 0;
 
   /**
    * @brief Executes a sell order.
@@ -46,12 +58,12 @@ public:
    * Must be implemented by derived classes.
    *
    * @param order Order to execute.
-   * @param data Current LOB snapshot.
+   * @param features Features bound to the current LOB snapshot.
    * @return Vector of execution fills.
    */
   virtual std::vector<common_types::ExecutionFill>
   execute_sell_order(const common_types::Order &order,
-                     const raw_data::LOBData &data) = 0;
+                     const BookFeatures &features) = 0;
 };
 
 /**
@@ -64,11 +76,11 @@ class LimitFokOrderExecutor final : public OrderExecutorAbstract {
 public:
   std::vector<common_types::ExecutionFill>
   execute_buy_order(const common_types::Order &order,
-                    const raw_data::LOBData &data) override;
+                    const BookFeatures &features) override;
 
   std::vector<common_types::ExecutionFill>
   execute_sell_order(const common_types::Order &order,
-                     const raw_data::LOBData &data) override;
+                     const BookFeatures &features) override;
 };
 
 /**
@@ -81,11 +93,11 @@ class LimitIocOrderExecutor final : public OrderExecutorAbstract {
 public:
   std::vector<common_types::ExecutionFill>
   execute_buy_order(const common_types::Order &order,
-                    const raw_data::LOBData &data) override;
+                    const BookFeatures &features) override;
 
   std::vector<common_types::ExecutionFill>
   execute_sell_order(const common_types::Order &order,
-                     const raw_data::LOBData &data) override;
+                     const BookFeatures &features) override;
 };
 
 /**
@@ -98,11 +110,11 @@ class MarketOrderExecutor final : public OrderExecutorAbstract {
 public:
   std::vector<common_types::ExecutionFill>
   execute_buy_order(const common_types::Order &order,
-                    const raw_data::LOBData &data) override;
+                    const BookFeatures &features) override;
 
   std::vector<common_types::ExecutionFill>
   execute_sell_order(const common_types::Order &order,
-                     const raw_data::LOBData &data) override;
+                     const BookFeatures &features) override;
 };
 
 /**
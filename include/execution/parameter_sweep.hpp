@@ -0,0 +1,169 @@
+#pragma once
+
+#include "data_loader/lob_arena.hpp"
+#include "data_loader/market_data_source.hpp"
+#include "types.hpp"
+#include "vaults/strategies.hpp"
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace vault::stats {
+class MetricsCalculator;
+}
+
+namespace execution {
+
+/// Values of the swept parameters of one backtest, by name.
+using ParameterSet = std::map<std::string, double>;
+
+/**
+ * @brief Cartesian product of named parameter values.
+ *
+ * Combinations are numbered with the last added parameter varying fastest.
+ */
+class ParameterGrid {
+public:
+  /**
+   * @brief Adds a parameter axis.
+   *
+   * @param name Parameter name, unique within the grid.
+   * @param values Values to try, at least one.
+   * @return ParameterGrid& The grid, to chain calls.
+   *
+   * @throws std::invalid_argument If values is empty or name is taken.
+   */
+  ParameterGrid &add(const std::string &name, std::vector<double> values);
+
+  /** @brief Returns number of combinations; 1 for a grid without axes. */
+  std::size_t size() const noexcept;
+
+  /**
+   * @brief Returns the i-th combination.
+   *
+   * @param i Index below size().
+   *
+   * @throws std::out_of_range If i is not below size().
+   */
+  ParameterSet at(std::size_t i) const;
+
+private:
+  /// Parameter names with their values, in insertion order.
+  std::vector<std::pair<std::string, std::vector<double>>> axes_;
+};
+
+/// @brief Outcome of the backtest of one parameter combination.
+struct SweepResult {
+  ParameterSet parameters;                         ///< Combination run.
+  std::unordered_map<std::string, double> metrics; ///< Metrics by name.
+  bool completed{false}; ///< Value returned by BacktestEngine::run().
+};
+
+/**
+ * @brief Backtests a strategy over every combination of a parameter grid.
+ *
+ * The dataset is loaded once and shared read-only: each combination gets
+ * its own BacktestEngine, Portfolio, MetricsCalculator and data source
+ * cursor over the same snapshots, so runs never copy the data. Runs are
+ * spread over a utils::ThreadPool; workers claim combinations one at a time
+ * from a shared counter, so a slow combination never holds back the ones
+ * after it.
+ *
+ * Build the library with NO_LOGGING for sweeps, debug output of concurrent
+ * runs is interleaved.
+ */
+class ParameterSweep {
+public:
+  /// Creates the strategy of one combination. Called concurrently.
+  using StrategyFactory =
+      std::function<vault::StrategyBase::UPtr(const ParameterSet &)>;
+
+  /// Registers extra metrics on the calculator of every run.
+  using MetricsSetup = std::function<void(vault::stats::MetricsCalculator &)>;
+
+  /**
+   * @brief Constructs the sweep over in-memory snapshots.
+   *
+   * @param lob_data Snapshots sorted by timestamp.
+   */
+  explicit ParameterSweep(
+      std::shared_ptr<const std::vector<raw_data::LOBData>> lob_data);
+
+  /**
+   * @brief Constructs the sweep over a packed snapshot arena.
+   *
+   * @param arena Snapshots sorted by timestamp.
+   */
+  explicit ParameterSweep(std::shared_ptr<const data_loading::LOBArena> arena);
+
+  /**
+   * @brief Sets market trades merged into the feed of every run.
+   *
+   * @param trades Trades sorted by timestamp.
+   */
+  inline void
+  set_trades(std::shared_ptr<const std::vector<raw_data::TradeData>> trades) {
+    trades_ = std::move(trades);
+  }
+
+  /** @brief Sets the fixed-point scale of the data. */
+  inline void set_instrument_scale(const common_types::InstrumentScale &scale) {
+    scale_ = scale;
+  }
+
+  /**
+   * @brief Sets the portfolio every run starts from.
+   *
+   * @param cash Initial cash balance.
+   * @param amount Initial asset amount.
+   */
+  inline void set_initial_portfolio(double cash, double amount = .0) {
+    initial_cash_ = cash;
+    initial_amount_ = amount;
+  }
+
+  /** @brief Sets the hook registering extra metrics on every run. */
+  inline void set_metrics_setup(MetricsSetup setup) {
+    metrics_setup_ = std::move(setup);
+  }
+
+  /**
+   * @brief Backtests every combination of the grid.
+   *
+   * @param grid Parameter combinations.
+   * @param factory Creates the strategy of a combination; must be safe to
+   * call from several threads at once.
+   * @param threads Number of worker threads; 0 means one per hardware
+   * thread.
+   * @return std::vector<SweepResult> One result per combination, in grid
+   * order.
+   *
+   * @throws Rethrows the first exception raised by a run, once every worker
+   * has stopped.
+   */
+  std::vector<SweepResult> run(const ParameterGrid &grid,
+                               const StrategyFactory &factory,
+                               std::size_t threads = 0) const;
+
+private:
+  /// Backtests one combination.
+  SweepResult run_one(const ParameterSet &parameters,
+                      const StrategyFactory &factory) const;
+
+private:
+  /// Creates a fresh cursor over the shared snapshots.
+  std::function<data_loading::MarketDataSource::UPtr()> make_source_;
+  /// Optional market trades.
+  std::shared_ptr<const std::vector<raw_data::TradeData>> trades_;
+  common_types::InstrumentScale scale_; ///< Scale of the data.
+  double initial_cash_{.0};             ///< Starting cash of every run.
+  double initial_amount_{.0};           ///< Starting assets of every run.
+  MetricsSetup metrics_setup_;          ///< Extra metrics, may be empty.
+};
+
+} // namespace execution
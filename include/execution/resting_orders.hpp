@@ -0,0 +1,184 @@
+#pragma once
+
+#include "execution/book_features.hpp"
+#include "types.hpp"
+#include "utils/id_map.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace execution {
+
+/**
+ * @brief Simulated queue positions of the engine's resting limit orders.
+ *
+ * A resting order joins the back of its price level: the amount displayed
+ * at that price when it is placed is queued ahead of it. The queue ahead
+ * shrinks when the displayed amount of the level decreases (net of the
+ * volume already seen trading there) and when market trades print at the
+ * price. Trade volume that gets past the queue fills the order. Trades
+ * printing through the price, or the opposite side of a snapshot crossing
+ * it, mean the market came through the level, and fill the order up to the
+ * liquidity that crossed. Crossing liquidity a level already traded with,
+ * on arrival or at an earlier snapshot, does not fill it again while it
+ * stays displayed. Fills are at the order's limit price. After a fill only
+ * the levels that filled are compacted.
+ *
+ * Levels of each side are kept in a vector sorted so that the best level
+ * is at the back, like L3OrderBook, and each level holds its orders in
+ * FIFO order. A snapshot only looks up the levels orders rest at, and a
+ * trade only the levels it reaches.
+ */
+class RestingOrderBook {
+public:
+  /// @brief Part of a resting order that was filled.
+  struct Fill {
+    common_types::Order order;        ///< Filled order, as submitted.
+    common_types::ExecutionFill fill; ///< Filled amount at the limit price.
+  };
+
+  /**
+   * @brief Constructs an empty book.
+   *
+   * @param expected_orders Number of resting orders to preallocate for.
+   */
+  explicit RestingOrderBook(std::size_t expected_orders = 64);
+
+  /**
+   * @brief Rests an order at the back of its price level.
+   *
+   * @param order Order to rest; its id must be unique and non-zero.
+   * @param amount Amount left to fill, at most order.amount.
+   * @param features Features of the current snapshot.
+   * @param crossed Crossing liquidity of the snapshot the order already
+   * took on arrival.
+   * @return true If the order rests, false if the id is already resting or
+   * the side is undefined.
+   */
+  bool add(const common_types::Order &order, common_types::Amount amount,
+           const BookFeatures &features,
+           common_types::Amount crossed = common_types::Amount{});
+
+  /**
+   * @brief Removes a resting order.
+   *
+   * @param id Order id.
+   * @return true If the order was resting.
+   */
+  bool cancel(std::uint64_t id);
+
+  /**
+   * @brief Returns the crossing liquidity own orders of a side already took
+   * from the current snapshot.
+   *
+   * @param side Side of an order arriving at `price`.
+   * @param price Limit price of the order.
+   * @param features Features of the current snapshot.
+   * @return Amount, at most the opposite depth at or through `price`.
+   */
+  common_types::Amount crossed(common_types::Side side,
+                               common_types::Price price,
+                               const BookFeatures &features) const;
+
+  /** @brief Returns true if an order with this id is resting. */
+  inline bool contains(std::uint64_t id) const {
+    return ids_.find(id) != nullptr;
+  }
+
+  /**
+   * @brief Returns the amount queued ahead of a resting order.
+   *
+   * @param id Order id.
+   * @param ahead Output displayed amount plus older own orders ahead.
+   * @return true If the order is resting.
+   */
+  bool queue_ahead(std::uint64_t id, common_types::Amount &ahead) const;
+
+  /** @brief Returns number of resting orders. */
+  inline std::size_t size() const noexcept { return ids_.size(); }
+
+  /** @brief Returns true if no order is resting. */
+  inline bool empty() const noexcept { return ids_.empty(); }
+
+  /**
+   * @brief Advances the queues to a new snapshot and fills crossed orders.
+   *
+   * @param features Features of the new snapshot.
+   * @param fills Output, fills are appended.
+   */
+  void on_snapshot(const BookFeatures &features, std::vector<Fill> &fills);
+
+  /**
+   * @brief Advances the queues with a market trade and fills the orders it
+   * reaches.
+   *
+   * @param trade Trade print; its side is the aggressor's, so a Sell trade
+   * reaches resting buy orders.
+   * @param fills Output, fills are appended.
+   */
+  void on_trade(const raw_data::TradeData &trade, std::vector<Fill> &fills);
+
+private:
+  /// @brief Resting order in its level queue.
+  struct Resting {
+    common_types::Order order;      ///< Order as submitted.
+    common_types::Amount remaining; ///< Amount left to fill.
+    /// Displayed amount between the previous own order of the level (or
+    /// the front of the queue) and this one.
+    common_types::Amount gap;
+  };
+
+  /// @brief Price level holding own orders.
+  struct Level {
+    common_types::Price price;      ///< Level price.
+    common_types::Amount displayed; ///< Amount displayed at the last update.
+    common_types::Amount traded;    ///< Volume printed since that update.
+    /// Opposite liquidity at or through the price already traded with.
+    common_types::Amount crossed;
+    std::vector<Resting> orders;    ///< Own orders, oldest first.
+  };
+
+  /// @brief Where a resting order lives.
+  struct Location {
+    common_types::Price price; ///< Level price.
+    common_types::Side side;   ///< Order side.
+  };
+
+  using Levels = std::vector<Level>;
+
+  /// Returns the levels of `side`: bids for Buy, asks for Sell.
+  inline Levels &levels(common_types::Side side) noexcept {
+    return side == common_types::Side::Buy ? bids_ : asks_;
+  }
+
+  /// Returns the levels of `side`: bids for Buy, asks for Sell.
+  inline const Levels &levels(common_types::Side side) const noexcept {
+    return side == common_types::Side::Buy ? bids_ : asks_;
+  }
+
+  /// Finds the position of `price` in `side`, or where it would go.
+  Levels::iterator locate(common_types::Side side, common_types::Price price);
+
+  /// @copydoc locate
+  Levels::const_iterator locate(common_types::Side side,
+                                common_types::Price price) const;
+
+  /// Moves `volume` through the queue of a level; fills only if `fill`.
+  static void consume(Level &level, common_types::Amount volume, bool fill,
+                      std::vector<Fill> &fills);
+
+  /// Fills the level orders with `volume`, ignoring the queue ahead.
+  static common_types::Amount sweep(Level &level, common_types::Amount volume,
+                                    std::vector<Fill> &fills);
+
+  /// Drops filled orders and empty levels among the levels of `side` from
+  /// index `first` on.
+  void compact(common_types::Side side, std::size_t first);
+
+private:
+  Levels bids_;                ///< Own buy levels, best (highest) last.
+  Levels asks_;                ///< Own sell levels, best (lowest) last.
+  utils::IdMap<Location> ids_; ///< Level of every resting order.
+};
+
+} // namespace execution
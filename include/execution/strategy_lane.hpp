@@ -0,0 +1,156 @@
+#pragma once
+
+#include "execution/book_features.hpp"
+#include "execution/market_engine.hpp"
+#include "types.hpp"
+#include "vaults/order_buffer.hpp"
+#include "vaults/portfolio.hpp"
+#include "vaults/strategies.hpp"
+#include <memory>
+#include <type_traits>
+
+namespace execution {
+
+/**
+ * @brief One strategy with its execution state, stepped event by event.
+ *
+ * Holds what a backtest keeps per strategy (the strategy, its portfolio,
+ * MarketEngine and order buffer) and the per-event logic feeding them.
+ * BacktestEngine and MultiStrategyEngine both drive their strategies
+ * through it, so an execution feature added here reaches both engines.
+ *
+ * @tparam Strategy vault::StrategyBase or a class derived from it; a
+ * concrete `final` class has its on_tick() called directly.
+ */
+template <class Strategy> class BasicStrategyLane {
+  static_assert(std::is_base_of_v<vault::StrategyBase, Strategy>,
+                "Strategy must derive from vault::StrategyBase");
+
+public:
+  /**
+   * @brief Sets the strategy and registers it for fill callbacks.
+   *
+   * @param p_strategy Unique pointer to the strategy.
+   */
+  inline void set_strategy(std::unique_ptr<Strategy> &&p_strategy) {
+    p_strategy_ = std::move(p_strategy);
+    exec_engine_.set_listener(p_strategy_.get());
+  }
+
+  /** @brief Returns the strategy, or nullptr if none was set. */
+  inline Strategy *strategy() const noexcept { return p_strategy_.get(); }
+
+  /** @brief Sets the portfolio updated by the strategy's orders. */
+  inline void set_portfolio(const vault::Portfolio::SPtr &portfolio) {
+    portfolio_ = portfolio;
+  }
+
+  /** @brief Returns the portfolio, or nullptr if none was set. */
+  inline const vault::Portfolio::SPtr &portfolio() const noexcept {
+    return portfolio_;
+  }
+
+  /** @brief Returns the engine executing the strategy's orders. */
+  inline MarketEngine &exec_engine() noexcept { return exec_engine_; }
+
+  /** @brief Returns true if both a strategy and a portfolio are set. */
+  inline bool ready() const noexcept {
+    return p_strategy_ != nullptr && portfolio_ != nullptr;
+  }
+
+  /** @brief Passes the instrument scale to the portfolio and strategy. */
+  inline void set_scale(const common_types::InstrumentScale &scale) {
+    portfolio_->set_scale(scale);
+    p_strategy_->set_scale(scale);
+  }
+
+  /**
+   * @brief Processes a market trade.
+   *
+   * Advances the resting orders with it, then executes the order the
+   * strategy places on it, alone, against the latest snapshot.
+   *
+   * @param trade Market trade.
+   * @param timestamp Event timestamp.
+   * @param features Features of the latest snapshot, or nullptr before the
+   * first one.
+   */
+  void on_trade(const raw_data::TradeData &trade, long long timestamp,
+                const BookFeatures *features) {
+    exec_engine_.advance_to(timestamp);
+    exec_engine_.on_market_trade(trade, portfolio_);
+    const auto order = p_strategy_->on_market_trade(trade);
+    if (!order.has_value()) {
+      return;
+    }
+    if (features != nullptr) {
+      exec_engine_.submit_and_tick(*order, timestamp, *features, portfolio_);
+    } else {
+      exec_engine_.add_order(*order, timestamp);
+    }
+  }
+
+  /**
+   * @brief Processes a snapshot: resting orders, strategy tick, orders,
+   * mark-to-market.
+   *
+   * @param book Snapshot, valid until the next snapshot.
+   * @param features Features bound to `book`.
+   * @return false If the snapshot is not two-sided; the portfolio is not
+   * marked to market then.
+   */
+  bool on_snapshot(const raw_data::LOBData &book,
+                   const BookFeatures &features) {
+    exec_engine_.advance_to(book.local_timestamp);
+    exec_engine_.update_resting(features, portfolio_);
+    p_strategy_->set_current_data(book, features);
+
+    orders_.clear();
+    collect_orders();
+
+    for (const auto id : orders_.cancels()) {
+      exec_engine_.cancel(id, book.local_timestamp);
+    }
+    exec_engine_.add_orders(orders_.orders(), book.local_timestamp);
+    exec_engine_.tick(features, portfolio_);
+
+    if (!features.two_sided()) {
+      return false;
+    }
+    portfolio_->update_portfolio_value(features.mid());
+    return true;
+  }
+
+private:
+  /// True if Strategy itself, or a class between it and StrategyBase,
+  /// overrides on_tick_batch().
+  static constexpr bool OVERRIDES_BATCH =
+      !std::is_same_v<decltype(&Strategy::on_tick_batch),
+                      void (vault::StrategyBase::*)(vault::OrderBuffer &)>;
+
+  /// Fills orders_ with the orders of the current tick.
+  inline void collect_orders() {
+    if constexpr (std::is_final_v<Strategy> && !OVERRIDES_BATCH) {
+      // The default on_tick_batch() would reach on_tick() through a
+      // virtual call; a final class lets it be called directly.
+      if (auto order = p_strategy_->on_tick()) {
+        orders_.push(*order);
+      }
+    } else {
+      p_strategy_->on_tick_batch(orders_);
+    }
+  }
+
+private:
+  std::unique_ptr<Strategy> p_strategy_; ///< Strategy under test.
+  vault::Portfolio::SPtr portfolio_;     ///< Portfolio of the strategy.
+  MarketEngine exec_engine_;             ///< Orders of the strategy.
+  vault::OrderBuffer orders_;            ///< Orders of the current tick.
+};
+
+/// Lane calling strategies through the StrategyBase interface.
+using StrategyLane = BasicStrategyLane<vault::StrategyBase>;
+
+extern template class BasicStrategyLane<vault::StrategyBase>;
+
+} // namespace execution
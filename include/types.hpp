@@ -1,19 +1,172 @@
 #pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
 #include <vector>
 
+#ifndef HFT_TASK_MAX_LOB_DEPTH
+/// Maximum number of levels per side stored in a LOB snapshot.
+#define HFT_TASK_MAX_LOB_DEPTH 25
+#endif
+
 /// @brief Order types supported by the execution engine.
 namespace execution::orders {
 enum class OrderTypes {
   Market,   ///< Market order: execute at best available price.
   LimitFok, ///< Limit Fill-or-Kill: execute fully at limit price or cancel.
-  LimitIoc  ///< Limit Immediate-or-Cancel: execute as much as possible at limit
+  LimitIoc, ///< Limit Immediate-or-Cancel: execute as much as possible at limit
             ///< price, cancel remainder.
+  LimitGtc, ///< Limit Good-till-Cancel: execute what crosses, rest remainder.
+  PostOnly  ///< Limit that only rests; rejected if it would cross.
 };
 } // namespace execution::orders
 
 /// @brief Common trading types used by strategies and portfolio.
 namespace common_types {
 
+#ifdef HFT_TASK_FIXED_POINT
+using Price = std::int64_t;  ///< Price in ticks of the instrument scale.
+using Amount = std::int64_t; ///< Amount in lots of the instrument scale.
+/// Product of a price and an amount (cash), in ticks * lots.
+__extension__ typedef __int128 Notional;
+/// Prices and amounts are stored as fixed-point integers.
+inline constexpr bool FIXED_POINT = true;
+#else
+using Price = double;    ///< Price in instrument units.
+using Amount = double;   ///< Amount in instrument units.
+using Notional = double; ///< Product of a price and an amount (cash).
+/// Prices and amounts are stored as doubles.
+inline constexpr bool FIXED_POINT = false;
+#endif
+
+/// @brief Returns the cash value of `amount` at `price`.
+inline Notional notional(Price price, Amount amount) noexcept {
+  return static_cast<Notional>(price) * amount;
+}
+
+/**
+ * @brief Fixed-point scale of one instrument.
+ *
+ * With HFT_TASK_FIXED_POINT a price `p` is stored as round(p * 10^price
+ * decimals) ticks and an amount `a` as round(a * 10^amount decimals) lots,
+ * so cash is kept exactly in ticks * lots. In the default floating-point
+ * build every conversion is the identity and the scale is ignored.
+ */
+class InstrumentScale {
+public:
+  /// Default number of decimal places of a price tick.
+  static constexpr int DEFAULT_PRICE_DECIMALS = 8;
+  /// Default number of decimal places of an amount lot.
+  static constexpr int DEFAULT_AMOUNT_DECIMALS = 8;
+
+  /// @brief Constructs the default scale.
+  InstrumentScale() = default;
+
+  /**
+   * @brief Constructs a scale from the number of decimal places.
+   *
+   * @param price_decimals Decimal places of a price tick.
+   * @param amount_decimals Decimal places of an amount lot.
+   *
+   * @throws std::invalid_argument If a value is outside [0, 18].
+   */
+  InstrumentScale(int price_decimals, int amount_decimals)
+      : price_decimals_(price_decimals), amount_decimals_(amount_decimals),
+        price_factor_(pow10(price_decimals)),
+        amount_factor_(pow10(amount_decimals)) {}
+
+  /** @brief Returns decimal places of a price tick. */
+  inline int price_decimals() const noexcept { return price_decimals_; }
+
+  /** @brief Returns decimal places of an amount lot. */
+  inline int amount_decimals() const noexcept { return amount_decimals_; }
+
+  /** @brief Converts a price in instrument units to a Price. */
+  inline Price to_price(double price) const noexcept {
+    if constexpr (FIXED_POINT) {
+      return static_cast<Price>(std::llround(price * price_factor_));
+    } else {
+      return static_cast<Price>(price);
+    }
+  }
+
+  /** @brief Converts a Price to instrument units. */
+  inline double from_price(Price price) const noexcept {
+    if constexpr (FIXED_POINT) {
+      return static_cast<double>(price) / price_factor_;
+    } else {
+      return static_cast<double>(price);
+    }
+  }
+
+  /** @brief Converts an amount in instrument units to an Amount. */
+  inline Amount to_amount(double amount) const noexcept {
+    if constexpr (FIXED_POINT) {
+      return static_cast<Amount>(std::llround(amount * amount_factor_));
+    } else {
+      return static_cast<Amount>(amount);
+    }
+  }
+
+  /** @brief Converts an Amount to instrument units. */
+  inline double from_amount(Amount amount) const noexcept {
+    if constexpr (FIXED_POINT) {
+      return static_cast<double>(amount) / amount_factor_;
+    } else {
+      return static_cast<double>(amount);
+    }
+  }
+
+  /** @brief Converts cash in instrument units to a Notional. */
+  inline Notional to_notional(double cash) const noexcept {
+    if constexpr (FIXED_POINT) {
+      return static_cast<Notional>(
+          std::round(cash * price_factor_ * amount_factor_));
+    } else {
+      return static_cast<Notional>(cash);
+    }
+  }
+
+  /** @brief Converts a Notional to instrument units. */
+  inline double from_notional(Notional cash) const noexcept {
+    if constexpr (FIXED_POINT) {
+      return static_cast<double>(cash) / (price_factor_ * amount_factor_);
+    } else {
+      return static_cast<double>(cash);
+    }
+  }
+
+  bool operator==(const InstrumentScale &other) const noexcept {
+    return price_decimals_ == other.price_decimals_ &&
+           amount_decimals_ == other.amount_decimals_;
+  }
+
+private:
+  /// Returns 10^decimals, validating the range.
+  static double pow10(int decimals) {
+    if (decimals < 0 || decimals > 18) {
+      throw std::invalid_argument("Scale decimals must be within [0, 18]");
+    }
+    double factor = 1.0;
+    for (int i = 0; i < decimals; ++i) {
+      factor *= 10.0;
+    }
+    return factor;
+  }
+
+private:
+  int price_decimals_{DEFAULT_PRICE_DECIMALS};   ///< Price tick decimals.
+  int amount_decimals_{DEFAULT_AMOUNT_DECIMALS}; ///< Amount lot decimals.
+  /// 10^price_decimals_.
+  double price_factor_{pow10(DEFAULT_PRICE_DECIMALS)};
+  /// 10^amount_decimals_.
+  double amount_factor_{pow10(DEFAULT_AMOUNT_DECIMALS)};
+};
+
 /// @brief Buy or Sell side of an order or trade.
 enum class Side {
   Undefined, ///< No side defined.
@@ -27,27 +180,39 @@ struct Order {
   execution::orders::OrderTypes order_type{
       ///< Order type.
       execution::orders::OrderTypes::Market};
-  double price{.0};  ///< Price per unit.
-  double amount{.0}; ///< Amount to buy or sell.
+  Price price{};       ///< Price per unit.
+  Amount amount{};     ///< Amount to buy or sell.
+  std::uint64_t id{0}; ///< Client order id, echoed in execution callbacks;
+                       ///< the engine numbers orders submitted with 0 from
+                       ///< MarketEngine::FIRST_ENGINE_ORDER_ID on.
+};
+
+/// @brief Why the engine could not execute an order.
+enum class RejectReason {
+  NoLiquidity,        ///< The book cannot fill the order within its terms.
+  InsufficientCash,   ///< The portfolio cannot pay for the buy fills.
+  InsufficientAssets, ///< The portfolio does not hold the amount to sell.
+  WouldCross,         ///< A PostOnly order would take liquidity.
+  DuplicateId         ///< An order with the same id is already resting.
 };
 
 /// @brief Represents an execution fill of an order.
 struct ExecutionFill {
-  double amount{.0}; ///< Amount filled.
-  double price{.0};  ///< Price at which the amount was filled.
+  Amount amount{}; ///< Amount filled.
+  Price price{};   ///< Price at which the amount was filled.
 };
 
 /// @brief Lot of assets in the portfolio.
 struct Lot {
-  double entry_price{.0}; ///< Price at which the lot was acquired.
-  double amount{.0};      ///< Quantity of the lot.
+  Price entry_price{}; ///< Price at which the lot was acquired.
+  Amount amount{};     ///< Quantity of the lot.
 };
 
 /// @brief Information about a closed or executed position.
 struct PositionInfo {
   Side action_type;        ///< Buy or Sell.
   Lot lot;                 ///< Lot involved in the trade.
-  double realised_pnl{.0}; ///< Realized profit or loss from this trade.
+  Notional realised_pnl{}; ///< Realized profit or loss from this trade.
 };
 
 } // namespace common_types
@@ -57,25 +222,226 @@ namespace raw_data {
 
 /// @brief Single entry in the order book.
 struct OrderBookEntry {
-  double price;  ///< Price level.
-  double amount; ///< Available amount at this price.
+  common_types::Price price;   ///< Price level.
+  common_types::Amount amount; ///< Available amount at this price.
 };
 
-/// @brief Snapshot of the limit order book at a given timestamp.
+/// Maximum number of levels per side of a snapshot; deeper levels are
+/// dropped when loading.
+inline constexpr std::size_t MAX_LOB_DEPTH = HFT_TASK_MAX_LOB_DEPTH;
+
+/**
+ * @brief One side of a snapshot: up to MAX_LOB_DEPTH levels stored inline.
+ *
+ * Prices and amounts are kept in two separate arrays (structure of arrays),
+ * so scans over one column load contiguous values and vectorize; see
+ * execution/depth_kernels.hpp. Elements are read as OrderBookEntry values
+ * and written with push_back() or set().
+ */
+class BookSide {
+public:
+  using value_type = OrderBookEntry;
+  using size_type = std::size_t;
+
+  /// @brief Read-only iterator yielding levels by value.
+  class const_iterator {
+  public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = OrderBookEntry;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = OrderBookEntry;
+
+    const_iterator() noexcept = default;
+    const_iterator(const BookSide *side, size_type i) noexcept
+        : side_(side), i_(i) {}
+
+    inline OrderBookEntry operator*() const noexcept { return (*side_)[i_]; }
+    inline const_iterator &operator++() noexcept {
+      ++i_;
+      return *this;
+    }
+    inline const_iterator operator++(int) noexcept {
+      const_iterator old = *this;
+      ++i_;
+      return old;
+    }
+    inline bool operator==(const const_iterator &other) const noexcept {
+      return i_ == other.i_;
+    }
+    inline bool operator!=(const const_iterator &other) const noexcept {
+      return i_ != other.i_;
+    }
+
+  private:
+    const BookSide *side_{nullptr}; ///< Iterated side.
+    size_type i_{0};                ///< Current level.
+  };
+
+  /** @brief Returns the maximum number of levels. */
+  static constexpr size_type capacity() noexcept { return MAX_LOB_DEPTH; }
+
+  /** @brief Returns number of levels. */
+  inline size_type size() const noexcept { return size_; }
+
+  /** @brief Returns true if there are no levels. */
+  inline bool empty() const noexcept { return size_ == 0; }
+
+  /** @brief Returns true if no level can be added. */
+  inline bool full() const noexcept { return size_ == MAX_LOB_DEPTH; }
+
+  inline OrderBookEntry operator[](size_type i) const noexcept {
+    return {prices_[i], amounts_[i]};
+  }
+  inline OrderBookEntry front() const noexcept { return (*this)[0]; }
+  inline OrderBookEntry back() const noexcept { return (*this)[size_ - 1]; }
+
+  /** @brief Returns the price column, valid in [0, size()). */
+  inline const common_types::Price *prices() const noexcept {
+    return prices_;
+  }
+
+  /** @brief Returns the amount column, valid in [0, size()). */
+  inline const common_types::Amount *amounts() const noexcept {
+    return amounts_;
+  }
+
+  inline const_iterator begin() const noexcept { return {this, 0}; }
+  inline const_iterator end() const noexcept { return {this, size_}; }
+
+  /** @brief Overwrites level `i`, which must be below size(). */
+  inline void set(size_type i, const OrderBookEntry &entry) noexcept {
+    prices_[i] = entry.price;
+    amounts_[i] = entry.amount;
+  }
+
+  /** @brief Removes every level. */
+  inline void clear() noexcept { size_ = 0; }
+
+  /**
+   * @brief Appends a level.
+   *
+   * @throws std::length_error If the side is full.
+   */
+  inline void push_back(const OrderBookEntry &entry) {
+    if (size_ == MAX_LOB_DEPTH) {
+      throw std::length_error("BookSide capacity exceeded");
+    }
+    set(size_++, entry);
+  }
+
+  /** @brief Removes the last level. */
+  inline void pop_back() noexcept { --size_; }
+
+  /**
+   * @brief Changes the number of levels; new ones are zero.
+   *
+   * @throws std::length_error If `count` exceeds the capacity.
+   */
+  inline void resize(size_type count) {
+    check_capacity(count);
+    for (size_type i = size_; i < count; ++i) {
+      set(i, {});
+    }
+    size_ = static_cast<std::uint32_t>(count);
+  }
+
+  /**
+   * @brief Replaces the contents with the levels in [first, last).
+   *
+   * @throws std::length_error If the range is longer than the capacity.
+   */
+  template <typename InputIt> void assign(InputIt first, InputIt last) {
+    const auto count = static_cast<size_type>(std::distance(first, last));
+    check_capacity(count);
+    for (size_type i = 0; i < count; ++i, ++first) {
+      set(i, *first);
+    }
+    size_ = static_cast<std::uint32_t>(count);
+  }
+
+  /**
+   * @brief Replaces the contents with `count` levels given as columns.
+   *
+   * @throws std::length_error If `count` exceeds the capacity.
+   */
+  inline void assign(const common_types::Price *prices,
+                     const common_types::Amount *amounts, size_type count) {
+    check_capacity(count);
+    std::copy(prices, prices + count, prices_);
+    std::copy(amounts, amounts + count, amounts_);
+    size_ = static_cast<std::uint32_t>(count);
+  }
+
+private:
+  /// Throws std::length_error if `count` levels do not fit.
+  static void check_capacity(size_type count) {
+    if (count > MAX_LOB_DEPTH) {
+      throw std::length_error("BookSide capacity exceeded");
+    }
+  }
+
+private:
+  std::uint32_t size_{0}; ///< Number of levels.
+  /// Level prices, valid in [0, size_).
+  alignas(32) common_types::Price prices_[MAX_LOB_DEPTH];
+  /// Level amounts, valid in [0, size_).
+  alignas(32) common_types::Amount amounts_[MAX_LOB_DEPTH];
+};
+
+/**
+ * @brief Snapshot of the limit order book at a given timestamp.
+ *
+ * Both sides are stored inline, so a snapshot is one contiguous, trivially
+ * copyable block and loading snapshots does not allocate per snapshot.
+ */
 struct LOBData {
   long long local_timestamp; ///< Timestamp of the snapshot.
-  std::vector<OrderBookEntry>
-      asks; ///< Ask side of the book (sorted ascending).
-  std::vector<OrderBookEntry>
-      bids; ///< Bid side of the book (sorted descending).
+  BookSide asks;             ///< Ask side of the book (sorted ascending).
+  BookSide bids;             ///< Bid side of the book (sorted descending).
 };
 
+static_assert(std::is_trivially_copyable_v<LOBData>,
+              "LOBData must stay trivially copyable");
+
 /// @brief Trade record used for backtesting or historical replay.
 struct TradeData {
-  long long local_timestamp; ///< Timestamp of the trade.
-  common_types::Side side;   ///< Buy or Sell.
-  double price;              ///< Price at which trade occurred.
-  double amount;             ///< Amount traded.
+  long long local_timestamp;   ///< Timestamp of the trade.
+  common_types::Side side;     ///< Buy or Sell.
+  common_types::Price price;   ///< Price at which trade occurred.
+  common_types::Amount amount; ///< Amount traded.
+};
+
+/**
+ * @brief Incremental change of one L2 price level.
+ *
+ * Replaces the amount resting at `price` on one side of the book; an amount
+ * of zero removes the level.
+ */
+struct L2Update {
+  long long local_timestamp;   ///< Timestamp of the update.
+  common_types::Side side;     ///< Buy for the bid side, Sell for the asks.
+  common_types::Price price;   ///< Price level.
+  common_types::Amount amount; ///< New amount at the level, 0 to remove it.
+};
+
+/// @brief Kind of an order-by-order (L3) event.
+enum class L3Action {
+  Add,     ///< New order joins the back of its price level.
+  Modify,  ///< Order changes price and/or amount.
+  Cancel,  ///< Order leaves the book.
+  Execute  ///< Order is (partially) filled by an aggressor.
+};
+
+/// @brief One order-by-order (L3) market event.
+struct L3Event {
+  long long local_timestamp;   ///< Timestamp of the event.
+  std::uint64_t order_id;      ///< Exchange order id.
+  L3Action action;             ///< Kind of the event.
+  common_types::Side side;     ///< Buy for bids, Sell for asks.
+  common_types::Price price;   ///< Order price (new price for Modify).
+  common_types::Amount amount; ///< Order amount, new amount for Modify,
+                               ///< filled amount for Execute.
 };
 
 } // namespace raw_data
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace utils {
+
+/**
+ * @brief Open-addressing hash map from 64-bit ids to small values.
+ *
+ * Slots live in one flat array probed linearly, so a lookup touches one or
+ * two cache lines and inserting never allocates until the table grows.
+ * Erasing shifts the following entries back instead of leaving tombstones,
+ * keeping probe sequences short under heavy add/cancel churn. The table is
+ * kept at most half full.
+ *
+ * @tparam Value Mapped type; must be trivially copyable.
+ */
+template <typename Value> class IdMap {
+public:
+  /// Reserved key marking an empty slot; it cannot be stored.
+  static constexpr std::uint64_t EMPTY_KEY =
+      std::numeric_limits<std::uint64_t>::max();
+
+  /**
+   * @brief Allocates the table.
+   *
+   * @param expected Number of ids expected to be stored at once.
+   */
+  explicit IdMap(std::size_t expected = 1024) { rehash(expected * 2); }
+
+  /** @brief Returns number of stored ids. */
+  inline std::size_t size() const noexcept { return size_; }
+
+  /** @brief Returns true if no id is stored. */
+  inline bool empty() const noexcept { return size_ == 0; }
+
+  /**
+   * @brief Returns a pointer to the value of `key`, or nullptr.
+   *
+   * The pointer is invalidated by the next insert() or erase().
+   */
+  inline Value *find(std::uint64_t key) noexcept {
+    std::size_t slot = index_of(key);
+    while (slots_[slot].key != EMPTY_KEY) {
+      if (slots_[slot].key == key) {
+        return &slots_[slot].value;
+      }
+      slot = (slot + 1) & mask_;
+    }
+    return nullptr;
+  }
+
+  /** @copydoc find(std::uint64_t) */
+  inline const Value *find(std::uint64_t key) const noexcept {
+    return const_cast<IdMap *>(this)->find(key);
+  }
+
+  /**
+   * @brief Inserts `key` unless it is already present.
+   *
+   * @param key Id to insert.
+   * @param value Value to map it to.
+   * @return true If inserted, false if the key was already present.
+   *
+   * @throws std::invalid_argument If `key` is EMPTY_KEY.
+   */
+  bool insert(std::uint64_t key, Value value) {
+    if (key == EMPTY_KEY) {
+      throw std::invalid_argument("IdMap: reserved key");
+    }
+    if ((size_ + 1) * 2 > slots_.size()) {
+      rehash(slots_.size() * 2);
+    }
+    std::size_t slot = index_of(key);
+    while (slots_[slot].key != EMPTY_KEY) {
+      if (slots_[slot].key == key) {
+        return false;
+      }
+      slot = (slot + 1) & mask_;
+    }
+    slots_[slot] = {key, value};
+    ++size_;
+    return true;
+  }
+
+  /**
+   * @brief Removes `key`.
+   *
+   * @return true If the key was present.
+   */
+  bool erase(std::uint64_t key) noexcept {
+    std::size_t slot = index_of(key);
+    while (slots_[slot].key != key) {
+      if (slots_[slot].key == EMPTY_KEY) {
+        return false;
+      }
+      slot = (slot + 1) & mask_;
+    }
+
+    // Backward shift: move later entries of the cluster into the hole when
+    // the hole lies between their home slot and their current slot.
+    std::size_t hole = slot;
+    std::size_t next = (hole + 1) & mask_;
+    while (slots_[next].key != EMPTY_KEY) {
+      const std::size_t home = index_of(slots_[next].key);
+      if (((next - home) & mask_) >= ((next - hole) & mask_)) {
+        slots_[hole] = slots_[next];
+        hole = next;
+      }
+      next = (next + 1) & mask_;
+    }
+    slots_[hole].key = EMPTY_KEY;
+    --size_;
+    return true;
+  }
+
+  /** @brief Removes every id, keeping the allocated table. */
+  void clear() noexcept {
+    for (auto &slot : slots_) {
+      slot.key = EMPTY_KEY;
+    }
+    size_ = 0;
+  }
+
+private:
+  /// @brief One table slot.
+  struct Slot {
+    std::uint64_t key{EMPTY_KEY}; ///< Stored id or EMPTY_KEY.
+    Value value{};                ///< Mapped value.
+  };
+
+  /// Home slot of `key` (splitmix64 finaliser, ids are often sequential).
+  inline std::size_t index_of(std::uint64_t key) const noexcept {
+    key ^= key >> 30;
+    key *= 0xbf58476d1ce4e5b9ULL;
+    key ^= key >> 27;
+    key *= 0x94d049bb133111ebULL;
+    key ^= key >> 31;
+    return static_cast<std::size_t>(key) & mask_;
+  }
+
+  /// Reallocates the table with at least `capacity` slots.
+  void rehash(std::size_t capacity) {
+    std::size_t slots = 16;
+    while (slots < capacity) {
+      slots *= 2;
+    }
+    std::vector<Slot> old(slots);
+    old.swap(slots_);
+    mask_ = slots - 1;
+    size_ = 0;
+    for (const auto &slot : old) {
+      if (slot.key != EMPTY_KEY) {
+        insert(slot.key, slot.value);
+      }
+    }
+  }
+
+private:
+  std::vector<Slot> slots_; ///< Power-of-two sized table.
+  std::size_t mask_{0};     ///< slots_.size() - 1.
+  std::size_t size_{0};     ///< Number of stored ids.
+};
+
+} // namespace utils
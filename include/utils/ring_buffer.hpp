@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+namespace utils {
+
+/**
+ * @brief Fixed-capacity double-ended ring buffer.
+ *
+ * Storage is allocated once by the constructor; pushing into a full buffer
+ * overwrites the oldest element, so no operation allocates afterwards.
+ * Elements are indexed from the oldest (0) to the newest (size() - 1).
+ *
+ * @tparam T Element type; must be default constructible and copyable.
+ */
+template <typename T> class RingBuffer {
+public:
+  /**
+   * @brief Allocates the buffer.
+   *
+   * @param capacity Maximum number of elements, must be positive.
+   *
+   * @throws std::invalid_argument If capacity is 0.
+   */
+  explicit RingBuffer(std::size_t capacity) : slots_(capacity) {
+    if (capacity == 0) {
+      throw std::invalid_argument("RingBuffer capacity must be positive");
+    }
+  }
+
+  /** @brief Returns maximum number of elements. */
+  inline std::size_t capacity() const noexcept { return slots_.size(); }
+
+  /** @brief Returns number of stored elements. */
+  inline std::size_t size() const noexcept { return size_; }
+
+  /** @brief Returns true if no element is stored. */
+  inline bool empty() const noexcept { return size_ == 0; }
+
+  /** @brief Returns true if the next push_back() evicts the oldest element. */
+  inline bool full() const noexcept { return size_ == slots_.size(); }
+
+  /** @brief Returns the oldest element; the buffer must not be empty. */
+  inline const T &front() const noexcept { return slots_[head_]; }
+
+  /** @brief Returns the newest element; the buffer must not be empty. */
+  inline const T &back() const noexcept { return (*this)[size_ - 1]; }
+
+  /**
+   * @brief Returns the i-th oldest element.
+   *
+   * @param i Index below size().
+   */
+  inline const T &operator[](std::size_t i) const noexcept {
+    return slots_[wrap(head_ + i)];
+  }
+
+  /**
+   * @brief Appends an element, overwriting the oldest one if full.
+   *
+   * @param value Element to append.
+   */
+  inline void push_back(const T &value) noexcept {
+    if (full()) {
+      slots_[head_] = value;
+      head_ = wrap(head_ + 1);
+      return;
+    }
+    slots_[wrap(head_ + size_)] = value;
+    ++size_;
+  }
+
+  /** @brief Removes the oldest element; the buffer must not be empty. */
+  inline void pop_front() noexcept {
+    head_ = wrap(head_ + 1);
+    --size_;
+  }
+
+  /** @brief Removes the newest element; the buffer must not be empty. */
+  inline void pop_back() noexcept { --size_; }
+
+  /** @brief Removes every element, keeping the storage. */
+  inline void clear() noexcept {
+    head_ = 0;
+    size_ = 0;
+  }
+
+private:
+  /// Maps an index in [0, 2 * capacity) onto a slot.
+  inline std::size_t wrap(std::size_t i) const noexcept {
+    return i >= slots_.size() ? i - slots_.size() : i;
+  }
+
+private:
+  std::vector<T> slots_; ///< Element storage.
+  std::size_t head_{0};  ///< Slot of the oldest element.
+  std::size_t size_{0};  ///< Number of stored elements.
+};
+
+} // namespace utils
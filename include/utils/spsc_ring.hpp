@@ -0,0 +1,104 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+namespace utils {
+
+/**
+ * @brief Bounded lock-free single-producer single-consumer ring buffer.
+ *
+ * Slots are allocated once and reused in place: the producer fills the slot
+ * returned by write_slot() and publishes it with commit_write(), the consumer
+ * reads the slot returned by read_slot() and hands it back with
+ * release_read(). Only one thread may produce and one thread may consume.
+ *
+ * @tparam T Slot type; must be default constructible.
+ */
+template <typename T> class SPSCRing {
+public:
+  /**
+   * @brief Allocates the ring.
+   *
+   * @param capacity Number of slots, must be a power of two.
+   *
+   * @throws std::invalid_argument If capacity is not a power of two.
+   */
+  explicit SPSCRing(std::size_t capacity)
+      : slots_(capacity), mask_(capacity - 1) {
+    if (capacity == 0 || (capacity & mask_) != 0) {
+      throw std::invalid_argument("SPSCRing capacity must be a power of two");
+    }
+  }
+
+  SPSCRing(const SPSCRing &) = delete;
+  SPSCRing &operator=(const SPSCRing &) = delete;
+
+  /** @brief Returns number of slots. */
+  inline std::size_t capacity() const noexcept { return slots_.size(); }
+
+  /**
+   * @brief Returns the next free slot, or nullptr if the ring is full.
+   *
+   * Producer side only.
+   */
+  inline T *write_slot() noexcept {
+    const std::size_t head = head_.load(std::memory_order_relaxed);
+    if (head - cached_tail_ == slots_.size()) {
+      cached_tail_ = tail_.load(std::memory_order_acquire);
+      if (head - cached_tail_ == slots_.size()) {
+        return nullptr;
+      }
+    }
+    return &slots_[head & mask_];
+  }
+
+  /** @brief Publishes the slot obtained from write_slot(). */
+  inline void commit_write() noexcept {
+    head_.store(head_.load(std::memory_order_relaxed) + 1,
+                std::memory_order_release);
+  }
+
+  /**
+   * @brief Returns the oldest published slot, or nullptr if the ring is
+   * empty.
+   *
+   * Consumer side only.
+   */
+  inline T *read_slot() noexcept {
+    const std::size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail == cached_head_) {
+      cached_head_ = head_.load(std::memory_order_acquire);
+      if (tail == cached_head_) {
+        return nullptr;
+      }
+    }
+    return &slots_[tail & mask_];
+  }
+
+  /** @brief Returns the slot obtained from read_slot() to the producer. */
+  inline void release_read() noexcept {
+    tail_.store(tail_.load(std::memory_order_relaxed) + 1,
+                std::memory_order_release);
+  }
+
+private:
+  static constexpr std::size_t CACHE_LINE = 64;
+
+  std::vector<T> slots_; ///< Preallocated slots.
+  std::size_t mask_;     ///< capacity - 1.
+
+  /// Next slot to write; written by the producer only.
+  alignas(CACHE_LINE) std::atomic<std::size_t> head_{0};
+  /// Producer's copy of tail_, refreshed only when the ring looks full.
+  std::size_t cached_tail_{0};
+
+  /// Next slot to read; written by the consumer only.
+  alignas(CACHE_LINE) std::atomic<std::size_t> tail_{0};
+  /// Consumer's copy of head_, refreshed only when the ring looks empty.
+  std::size_t cached_head_{0};
+};
+
+} // namespace utils
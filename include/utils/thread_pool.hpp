@@ -0,0 +1,71 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace utils {
+
+/**
+ * @brief Fixed-size pool of worker threads executing submitted tasks.
+ *
+ * Tasks are taken from a shared FIFO queue. The destructor finishes all
+ * queued tasks before joining the workers.
+ */
+class ThreadPool {
+public:
+  /**
+   * @brief Starts the worker threads.
+   *
+   * @param threads Number of workers; 0 means one per hardware thread.
+   */
+  explicit ThreadPool(std::size_t threads = 0);
+
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  /** @brief Returns number of worker threads. */
+  inline std::size_t size() const noexcept { return workers_.size(); }
+
+  /**
+   * @brief Queues a task for execution.
+   *
+   * @param fn Callable without arguments.
+   * @return std::future holding the result (or exception) of the task.
+   */
+  template <typename Fn>
+  std::future<std::invoke_result_t<Fn>> submit(Fn &&fn) {
+    using ResultT = std::invoke_result_t<Fn>;
+    auto task =
+        std::make_shared<std::packaged_task<ResultT()>>(std::forward<Fn>(fn));
+    auto result = task->get_future();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      tasks_.emplace([task]() { (*task)(); });
+    }
+    cv_.notify_one();
+    return result;
+  }
+
+private:
+  /// Worker loop: pops and runs tasks until the pool is stopped.
+  void worker_loop();
+
+private:
+  std::vector<std::thread> workers_;        ///< Worker threads.
+  std::queue<std::function<void()>> tasks_; ///< Pending tasks.
+  std::mutex mutex_;                        ///< Guards tasks_ and stop_.
+  std::condition_variable cv_;              ///< Signals new tasks or stop.
+  bool stop_{false};                        ///< Set by the destructor.
+};
+
+} // namespace utils
@@ -0,0 +1,367 @@
+#pragma once
+
+#include "execution/book_features.hpp"
+#include "utils/ring_buffer.hpp"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+
+/**
+ * @brief Streaming indicators for strategies.
+ *
+ * Every indicator is updated with one sample at a time in O(1) (amortized
+ * for the rolling extrema) and allocates its window once, in the
+ * constructor. Samples are plain doubles, typically prices in instrument
+ * units as returned by StrategyBase::mid_price().
+ */
+namespace vault::indicators {
+
+namespace detail {
+/**
+ * @brief Running sum with Neumaier compensation.
+ *
+ * Sliding windows add and subtract every sample once; compensation keeps
+ * the rounding error of the sum bounded however long the series is.
+ */
+class CompensatedSum {
+public:
+  /** @brief Adds `x` to the sum. */
+  inline void add(double x) noexcept {
+    const double t = sum_ + x;
+    if (std::fabs(sum_) >= std::fabs(x)) {
+      compensation_ += (sum_ - t) + x;
+    } else {
+      compensation_ += (x - t) + sum_;
+    }
+    sum_ = t;
+  }
+
+  /** @brief Returns the compensated sum. */
+  inline double value() const noexcept { return sum_ + compensation_; }
+
+private:
+  double sum_{0.0};          ///< Naive running sum.
+  double compensation_{0.0}; ///< Accumulated rounding error.
+};
+
+/// Throws if a window is empty.
+inline std::size_t check_window(std::size_t window) {
+  if (window == 0) {
+    throw std::invalid_argument("Indicator window must be positive");
+  }
+  return window;
+}
+} // namespace detail
+
+/// @brief Simple moving average over the last `window` samples.
+class SMA {
+public:
+  /**
+   * @brief Constructs the average.
+   *
+   * @param window Number of samples averaged.
+   *
+   * @throws std::invalid_argument If window is 0.
+   */
+  explicit SMA(std::size_t window) : samples_(detail::check_window(window)) {}
+
+  /** @brief Adds a sample, dropping the oldest one once the window is full. */
+  inline void update(double x) noexcept {
+    if (samples_.full()) {
+      sum_.add(-samples_.front());
+    }
+    samples_.push_back(x);
+    sum_.add(x);
+  }
+
+  /** @brief Returns the average of the samples seen so far, 0 if none. */
+  inline double value() const noexcept {
+    return samples_.empty() ? 0.0 : sum_.value() / samples_.size();
+  }
+
+  /** @brief Returns true once `window` samples were seen. */
+  inline bool ready() const noexcept { return samples_.full(); }
+
+  /** @brief Returns the window length. */
+  inline std::size_t window() const noexcept { return samples_.capacity(); }
+
+private:
+  utils::RingBuffer<double> samples_; ///< Samples in the window.
+  detail::CompensatedSum sum_;        ///< Sum of the window.
+};
+
+/// @brief Exponential moving average.
+class EMA {
+public:
+  /**
+   * @brief Constructs the average with smoothing 2 / (period + 1).
+   *
+   * @param period Number of samples of the equivalent SMA.
+   *
+   * @throws std::invalid_argument If period is 0.
+   */
+  explicit EMA(std::size_t period)
+      : alpha_(2.0 / (detail::check_window(period) + 1.0)), period_(period) {}
+
+  /** @brief Adds a sample; the first sample seeds the average. */
+  inline void update(double x) noexcept {
+    value_ = count_ == 0 ? x : value_ + alpha_ * (x - value_);
+    ++count_;
+  }
+
+  /** @brief Returns the current average, 0 before the first sample. */
+  inline double value() const noexcept { return value_; }
+
+  /** @brief Returns true once `period` samples were seen. */
+  inline bool ready() const noexcept { return count_ >= period_; }
+
+  /** @brief Returns the smoothing factor. */
+  inline double alpha() const noexcept { return alpha_; }
+
+private:
+  double alpha_;           ///< Weight of the newest sample.
+  std::size_t period_;     ///< Samples until ready().
+  double value_{0.0};      ///< Current average.
+  std::uint64_t count_{0}; ///< Samples seen.
+};
+
+/**
+ * @brief Mean, variance and standard deviation over the last `window`
+ * samples.
+ *
+ * Fed with returns, stddev() is the rolling volatility. Uses Welford's
+ * update, extended to remove the sample leaving the window.
+ */
+class RollingVariance {
+public:
+  /**
+   * @brief Constructs the estimator.
+   *
+   * @param window Number of samples in the window.
+   *
+   * @throws std::invalid_argument If window is 0.
+   */
+  explicit RollingVariance(std::size_t window)
+      : samples_(detail::check_window(window)) {}
+
+  /** @brief Adds a sample, dropping the oldest one once the window is full. */
+  inline void update(double x) noexcept {
+    if (!samples_.full()) {
+      samples_.push_back(x);
+      const double delta = x - mean_;
+      mean_ += delta / samples_.size();
+      m2_ += delta * (x - mean_);
+      return;
+    }
+    const double y = samples_.front();
+    samples_.push_back(x);
+    const double old_mean = mean_;
+    mean_ += (x - y) / samples_.size();
+    m2_ += (x - y) * (x - mean_ + y - old_mean);
+  }
+
+  /** @brief Returns the mean of the window. */
+  inline double mean() const noexcept { return mean_; }
+
+  /** @brief Returns the sample variance, 0 with fewer than two samples. */
+  inline double variance() const noexcept {
+    if (samples_.size() < 2 || m2_ <= 0.0) {
+      return 0.0;
+    }
+    return m2_ / (samples_.size() - 1);
+  }
+
+  /** @brief Returns the sample standard deviation. */
+  inline double stddev() const noexcept { return std::sqrt(variance()); }
+
+  /** @brief Returns true once `window` samples were seen. */
+  inline bool ready() const noexcept { return samples_.full(); }
+
+private:
+  utils::RingBuffer<double> samples_; ///< Samples in the window.
+  double mean_{0.0};                  ///< Mean of the window.
+  double m2_{0.0};                    ///< Sum of squared deviations.
+};
+
+/**
+ * @brief Extremum of the last `window` samples, kept in a monotonic deque.
+ *
+ * The deque holds only the samples that can still become the extremum, so
+ * each sample is pushed and popped at most once.
+ *
+ * @tparam Compare Strict ordering; std::less gives the minimum.
+ */
+template <class Compare> class RollingExtremum {
+public:
+  /**
+   * @brief Constructs the indicator.
+   *
+   * @param window Number of samples in the window.
+   *
+   * @throws std::invalid_argument If window is 0.
+   */
+  explicit RollingExtremum(std::size_t window)
+      : candidates_(detail::check_window(window)) {}
+
+  /** @brief Adds a sample, dropping the oldest one once the window is full. */
+  inline void update(double x) noexcept {
+    while (!candidates_.empty() && !Compare{}(candidates_.back().value, x)) {
+      candidates_.pop_back();
+    }
+    if (!candidates_.empty() &&
+        candidates_.front().seq + candidates_.capacity() <= count_) {
+      candidates_.pop_front();
+    }
+    candidates_.push_back({count_++, x});
+  }
+
+  /** @brief Returns the extremum of the window, 0 before the first sample. */
+  inline double value() const noexcept {
+    return candidates_.empty() ? 0.0 : candidates_.front().value;
+  }
+
+  /** @brief Returns true once `window` samples were seen. */
+  inline bool ready() const noexcept {
+    return count_ >= candidates_.capacity();
+  }
+
+private:
+  /// @brief Sample that may still become the extremum.
+  struct Candidate {
+    std::uint64_t seq; ///< Position of the sample in the series.
+    double value;      ///< Sample value.
+  };
+
+  utils::RingBuffer<Candidate> candidates_; ///< Monotonic deque.
+  std::uint64_t count_{0};                  ///< Samples seen.
+};
+
+/// Minimum of the last samples.
+using RollingMin = RollingExtremum<std::less<double>>;
+
+/// Maximum of the last samples.
+using RollingMax = RollingExtremum<std::greater<double>>;
+
+/// @brief Volume-weighted average price of the last `window` trades.
+class RollingVWAP {
+public:
+  /**
+   * @brief Constructs the average.
+   *
+   * @param window Number of trades averaged.
+   *
+   * @throws std::invalid_argument If window is 0.
+   */
+  explicit RollingVWAP(std::size_t window)
+      : trades_(detail::check_window(window)) {}
+
+  /**
+   * @brief Adds a trade, dropping the oldest one once the window is full.
+   *
+   * @param price Trade price.
+   * @param amount Traded amount.
+   */
+  inline void update(double price, double amount) noexcept {
+    if (trades_.full()) {
+      notional_.add(-trades_.front().notional);
+      amount_.add(-trades_.front().amount);
+    }
+    trades_.push_back({price * amount, amount});
+    notional_.add(price * amount);
+    amount_.add(amount);
+  }
+
+  /** @brief Returns the VWAP of the window, 0 if nothing was traded. */
+  inline double value() const noexcept {
+    const double amount = amount_.value();
+    return amount > 0.0 ? notional_.value() / amount : 0.0;
+  }
+
+  /** @brief Returns true once `window` trades were seen. */
+  inline bool ready() const noexcept { return trades_.full(); }
+
+private:
+  /// @brief One trade of the window.
+  struct Trade {
+    double notional; ///< Price * amount.
+    double amount;   ///< Traded amount.
+  };
+
+  utils::RingBuffer<Trade> trades_; ///< Trades in the window.
+  detail::CompensatedSum notional_; ///< Notional of the window.
+  detail::CompensatedSum amount_;   ///< Amount of the window.
+};
+
+/**
+ * @brief Order book imbalance averaged over the last `window` snapshots.
+ *
+ * (bid depth - ask depth) / (bid depth + ask depth) of the summed depths,
+ * in [-1, 1].
+ */
+class RollingImbalance {
+public:
+  /**
+   * @brief Constructs the indicator.
+   *
+   * @param window Number of snapshots in the window.
+   *
+   * @throws std::invalid_argument If window is 0.
+   */
+  explicit RollingImbalance(std::size_t window)
+      : depths_(detail::check_window(window)) {}
+
+  /**
+   * @brief Adds the resting depth of one snapshot.
+   *
+   * @param bid_depth Amount resting on the bid side.
+   * @param ask_depth Amount resting on the ask side.
+   */
+  inline void update(double bid_depth, double ask_depth) noexcept {
+    if (depths_.full()) {
+      bids_.add(-depths_.front().bid);
+      asks_.add(-depths_.front().ask);
+    }
+    depths_.push_back({bid_depth, ask_depth});
+    bids_.add(bid_depth);
+    asks_.add(ask_depth);
+  }
+
+  /**
+   * @brief Adds the depth of the first `levels` levels of a snapshot.
+   *
+   * Uses the cached cumulative depth of the features.
+   *
+   * @param features Features of the snapshot, e.g. StrategyBase::features().
+   * @param levels Number of levels per side.
+   */
+  inline void update(const execution::BookFeatures &features,
+                     std::size_t levels) noexcept {
+    update(static_cast<double>(features.bid_depth(levels)),
+           static_cast<double>(features.ask_depth(levels)));
+  }
+
+  /** @brief Returns the imbalance of the window, 0 if both sides are empty. */
+  inline double value() const noexcept {
+    const double bids = bids_.value();
+    const double asks = asks_.value();
+    return bids + asks > 0.0 ? (bids - asks) / (bids + asks) : 0.0;
+  }
+
+  /** @brief Returns true once `window` snapshots were seen. */
+  inline bool ready() const noexcept { return depths_.full(); }
+
+private:
+  /// @brief Depths of one snapshot.
+  struct Depth {
+    double bid; ///< Bid depth.
+    double ask; ///< Ask depth.
+  };
+
+  utils::RingBuffer<Depth> depths_; ///< Depths in the window.
+  detail::CompensatedSum bids_;     ///< Bid depth of the window.
+  detail::CompensatedSum asks_;     ///< Ask depth of the window.
+};
+
+} // namespace vault::indicators
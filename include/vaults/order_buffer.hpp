@@ -0,0 +1,75 @@
+#pragma once
+
+#include "types.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace vault {
+
+/**
+ * @brief Reusable buffer collecting the orders a strategy submits on a tick.
+ *
+ * The engine owns one buffer and clears it before every tick. clear() keeps
+ * the storage, so once the buffer has grown to the largest batch seen,
+ * submitting orders does not allocate.
+ */
+class OrderBuffer {
+public:
+  /**
+   * @brief Constructs an empty buffer.
+   *
+   * @param capacity Number of orders to reserve room for.
+   */
+  explicit OrderBuffer(std::size_t capacity = 16) { orders_.reserve(capacity); }
+
+  /**
+   * @brief Appends an order to the batch.
+   *
+   * @param order Order to submit.
+   */
+  inline void push(const common_types::Order &order) {
+    orders_.push_back(order);
+  }
+
+  /**
+   * @brief Requests the cancellation of a resting or pending order.
+   *
+   * Cancellations are applied before the orders of the same batch.
+   *
+   * @param id Id of the order to cancel.
+   */
+  inline void cancel(std::uint64_t id) { cancels_.push_back(id); }
+
+  /** @brief Removes every order and cancellation, keeping the storage. */
+  inline void clear() noexcept {
+    orders_.clear();
+    cancels_.clear();
+  }
+
+  /** @brief Returns number of orders in the batch. */
+  inline std::size_t size() const noexcept { return orders_.size(); }
+
+  /** @brief Returns true if no order was submitted. */
+  inline bool empty() const noexcept { return orders_.empty(); }
+
+  /** @brief Returns the batch as a read-only span, in submission order. */
+  inline std::span<const common_types::Order> orders() const noexcept {
+    return orders_;
+  }
+
+  /** @brief Returns the ids to cancel, in request order. */
+  inline std::span<const std::uint64_t> cancels() const noexcept {
+    return cancels_;
+  }
+
+  inline auto begin() const noexcept { return orders_.begin(); }
+  inline auto end() const noexcept { return orders_.end(); }
+
+private:
+  std::vector<common_types::Order> orders_; ///< Orders of the current tick.
+  std::vector<std::uint64_t> cancels_;      ///< Ids to cancel.
+};
+
+} // namespace vault
@@ -37,13 +37,38 @@ public:
                      const double initial_amount = .0);
 
   /** @brief Sets the cash balance. */
-  inline void set_cash(const double cash) { cash_ = cash; }
+  inline void set_cash(const double cash) { cash_ = scale_.to_notional(cash); }
 
   /** @brief Sets the asset amount. */
-  inline void set_amount(const double amount) { asset_amount_ = amount; }
+  inline void set_amount(const double amount) {
+    asset_amount_ = scale_.to_amount(amount);
+  }
 
   /** @brief Returns current cash balance. */
-  inline double get_cash_amount() const noexcept { return cash_; }
+  inline double get_cash_amount() const noexcept {
+    return scale_.from_notional(cash_);
+  }
+
+  /** @brief Returns current asset amount. */
+  inline double get_asset_amount() const noexcept {
+    return scale_.from_amount(asset_amount_);
+  }
+
+  /**
+   * @brief Sets the fixed-point scale of the traded instrument.
+   *
+   * The current cash and asset balances are re-expressed in the new scale.
+   *
+   * @param scale Instrument scale used by the executed fills.
+   *
+   * @throws std::runtime_error If the scale changes after trades were made.
+   */
+  void set_scale(const common_types::InstrumentScale &scale);
+
+  /** @brief Returns the fixed-point scale of the traded instrument. */
+  inline const common_types::InstrumentScale &scale() const noexcept {
+    return scale_;
+  }
 
   /** @brief Returns trade history of the portfolio. */
   inline const std::vector<common_types::PositionInfo> &
@@ -63,7 +88,7 @@ public:
    * @return double Total portfolio value.
    */
   inline double get_current_portfolio_value(double current_price) const {
-    return cash_ + asset_amount_ * current_price;
+    return get_cash_amount() + get_asset_amount() * current_price;
   }
 
   /**
@@ -129,13 +154,15 @@ private:
    *
    * @param amount Amount being sold.
    * @param sell_price Execution price.
-   * @return double Realized PnL from this sell.
+   * @return common_types::Notional Realized PnL from this sell.
    */
-  double calculate_realized_pnl(double amount, double sell_price);
+  common_types::Notional calculate_realized_pnl(common_types::Amount amount,
+                                                common_types::Price sell_price);
 
 private:
-  double cash_{.0};                                       ///< Cash balance
-  double asset_amount_{.0};                               ///< Asset holdings
+  common_types::InstrumentScale scale_;                   ///< Price scale
+  common_types::Notional cash_{};                         ///< Cash balance
+  common_types::Amount asset_amount_{};                   ///< Asset holdings
   std::vector<common_types::PositionInfo> trade_history_; ///< Buy/Sell history
   std::deque<common_types::Lot> positions_; ///< Open positions (FIFO)
   std::vector<double> portfolio_values_;    ///< Portfolio value history
@@ -22,7 +22,7 @@ public:
   /**
    * @brief Processes the next tick and possibly generates an order.
    *
-   * Compares the current LOB tick timestamp (current_data_.local_timestamp)
+   * Compares the current LOB tick timestamp (current_data().local_timestamp)
    * with the timestamp of the next trade in the trades vector. If the tick is
    * at or after the trade timestamp, returns a Limit IOC order matching that
    * trade.
@@ -38,4 +38,25 @@ private:
       trade_it_; ///< Iterator to the next trade to execute.
 };
 
+/**
+ * @brief Strategy that mirrors market trades of the merged event feed.
+ *
+ * Unlike StrategyFromTradesFile, which emits at most one trade per LOB tick,
+ * every trade print set with BacktestEngine::add_trades() is turned into a
+ * Limit IOC order as soon as it is replayed, executed against the latest
+ * snapshot, so bursts of trades between two snapshots do not lag behind.
+ */
+class StrategyFromTradesFeed : public StrategyBase {
+public:
+  /**
+   * @brief Returns a Limit IOC order matching the trade.
+   *
+   * @param trade Market trade print.
+   * @return std::optional<common_types::Order> Order with the price, amount
+   * and side of the trade.
+   */
+  std::optional<common_types::Order>
+  on_market_trade(const raw_data::TradeData &trade) override;
+};
+
 } // namespace vault
@@ -1,14 +1,24 @@
 #pragma once
 
+#include "execution/book_features.hpp"
+#include "execution/execution_listener.hpp"
 #include "types.hpp"
+#include "vaults/order_buffer.hpp"
 #include <cstdlib>
 #include <memory>
 #include <optional>
 
 namespace vault {
 
-/// @brief Base class for all trading strategies.
-class StrategyBase {
+/**
+ * @brief Base class for all trading strategies.
+ *
+ * The engine registers the strategy as the execution listener, so
+ * on_fill() and on_order_rejected() report the outcome of its orders as
+ * they are executed; strategies can keep incremental state from them
+ * instead of polling the portfolio.
+ */
+class StrategyBase : public execution::ExecutionListener {
 public:
   using UPtr = std::unique_ptr<StrategyBase>;
 
@@ -18,50 +28,135 @@ public:
   /**
    * @brief Called on each tick of LOB data to generate an order.
    *
-   * Derived classes must implement this method to define strategy behavior.
-   * It can return an order or std::nullopt if no action is needed.
+   * Derived classes implement this method, or on_tick_batch() to submit
+   * several orders per tick. It can return an order or std::nullopt if no
+   * action is needed; the default does nothing.
    *
    * @return std::optional<common_types::Order> The order to execute, or
    * std::nullopt.
    */
-  virtual std::optional<common_types::Order> on_tick() = 0;
+  virtual std::optional<common_types::Order> on_tick() { return std::nullopt; }
+
+  /**
+   * @brief Called on each tick of LOB data to submit any number of orders.
+   *
+   * The engine passes the same buffer, cleared, on every tick and executes
+   * the whole batch against the current snapshot in submission order. The
+   * default forwards to on_tick().
+   *
+   * @param orders Engine-owned buffer to push the orders of this tick into.
+   */
+  virtual void on_tick_batch(OrderBuffer &orders) {
+    if (auto order = on_tick()) {
+      orders.push(*order);
+    }
+  }
+
+  /**
+   * @brief Called on each market trade print merged into the feed.
+   *
+   * Only invoked when the engine has a trade source. current_data() still
+   * returns the latest snapshot at or before the trade. The default
+   * implementation ignores trades.
+   *
+   * @param trade Market trade print.
+   * @return std::optional<common_types::Order> The order to execute against
+   * the latest snapshot, or std::nullopt.
+   */
+  virtual std::optional<common_types::Order>
+  on_market_trade(const raw_data::TradeData & /*trade*/) {
+    return std::nullopt;
+  }
 
   /**
    * @brief Sets the current LOB data for the strategy.
    *
    * This is typically called by the backtest or live engine before on_tick().
+   * The snapshot is not copied: it must stay valid until the strategy
+   * callbacks for this tick have returned.
    *
    * @param data Reference to current LOB data.
    */
-  void set_current_data(const raw_data::LOBData &data) { current_data_ = data; }
+  void set_current_data(const raw_data::LOBData &data) {
+    own_features_.reset(data);
+    features_ = nullptr;
+  }
+
+  /**
+   * @brief Sets the current LOB data together with features shared by the
+   * engine.
+   *
+   * Values computed by the strategy, the engine or the executors are then
+   * computed once per snapshot.
+   *
+   * @param data Reference to current LOB data, not copied.
+   * @param features Features bound to `data`; must outlive the tick.
+   */
+  void set_current_data(const raw_data::LOBData &data,
+                        const execution::BookFeatures &features) {
+    own_features_.reset(data);
+    features_ = &features;
+  }
+
+  /**
+   * @brief Sets the fixed-point scale used by the order helpers.
+   *
+   * This is typically called by the backtest engine before the first tick.
+   *
+   * @param scale Scale of the traded instrument.
+   */
+  void set_scale(const common_types::InstrumentScale &scale) {
+    scale_ = scale;
+    own_features_.set_scale(scale);
+  }
 
 protected:
+  /**
+   * @brief Returns the current LOB snapshot.
+   *
+   * A non-owning view of the engine's snapshot, valid during on_tick() and
+   * on_market_trade(); an empty book before the first tick.
+   */
+  inline const raw_data::LOBData &current_data() const {
+    return own_features_.data();
+  }
+
+  /**
+   * @brief Returns the cached features of the current snapshot (mid,
+   * spread, microprice, imbalance, cumulative depth).
+   */
+  inline const execution::BookFeatures &features() const {
+    return features_ != nullptr ? *features_ : own_features_;
+  }
+
   /**
    * @brief Returns the mid price between the best bid and best ask.
    *
    * @return double Mid price.
    */
-  inline double mid_price() const { return (best_bid() + best_ask()) / 2.0; }
+  inline double mid_price() const { return features().mid(); }
 
   /**
    * @brief Returns the best bid price from the current LOB data.
    *
-   * @return double Best bid price, or 0 if no bids are present.
+   * @return double Best bid price in instrument units, or 0 if no bids are
+   * present.
    */
-  double best_bid() const;
+  inline double best_bid() const { return features().best_bid(); }
 
   /**
    * @brief Returns the best ask price from the current LOB data.
    *
-   * @return double Best ask price, or 0 if no asks are present.
+   * @return double Best ask price in instrument units, or 0 if no asks are
+   * present.
    */
-  double best_ask() const;
+  inline double best_ask() const { return features().best_ask(); }
 
   /**
    * @brief Creates a buy order with the given amount and optional price.
    *
-   * @param amount Amount to buy.
-   * @param price Optional limit price; 0 indicates market/IOC by default.
+   * @param amount Amount to buy in instrument units.
+   * @param price Optional limit price; 0 uses the best ask.
    * @return common_types::Order Buy order object.
    */
   common_types::Order create_buy_order(double amount, double price = .0) const;
@@ -69,13 +164,20 @@ protected:
   /**
    * @brief Creates a sell order with the given amount and optional price.
    *
-   * @param amount Amount to sell.
-   * @param price Optional limit price; 0 indicates market/IOC by default.
+   * @param amount Amount to sell in instrument units.
+   * @param price Optional limit price; 0 uses the best bid.
    * @return common_types::Order Sell order object.
    */
   common_types::Order create_sell_order(double amount, double price = .0) const;
 
 protected:
-  raw_data::LOBData current_data_; ///< Current LOB snapshot for this tick.
+  common_types::InstrumentScale scale_; ///< Scale of prices and amounts.
+
+private:
+  /// Bound to the current snapshot; its features are used when the engine
+  /// shares none.
+  execution::BookFeatures own_features_;
+  /// Features shared by the engine for this tick, or nullptr.
+  const execution::BookFeatures *features_{nullptr};
 };
 } // namespace vault
@@ -0,0 +1,269 @@
+#include "data_loader/binary_format.hpp"
+#include "logging.hpp"
+#include "types.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace {
+template <typename T>
+void write_values(std::ofstream &out, const T *values, std::size_t count) {
+  out.write(reinterpret_cast<const char *>(values),
+            static_cast<std::streamsize>(count * sizeof(T)));
+}
+
+/// Writes one level column (price or amount of one side), zero padded.
+template <typename T, typename Getter>
+void write_level_column(std::ofstream &out,
+                        const std::vector<raw_data::LOBData> &lob_data,
+                        std::size_t depth, Getter get) {
+  std::vector<T> row(depth);
+  for (const auto &snapshot : lob_data) {
+    std::fill(row.begin(), row.end(), T{});
+    get(snapshot, row);
+    write_values(out, row.data(), row.size());
+  }
+}
+
+std::ofstream open_output(const std::string &filename) {
+  std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+  if (!out.is_open()) {
+    throw std::runtime_error("Cannot open file for writing: " + filename);
+  }
+  return out;
+}
+
+/// Fills the scale and representation fields of a header.
+void set_scale(data_loading::binary::FileHeader &header,
+               const common_types::InstrumentScale &scale) {
+  if constexpr (common_types::FIXED_POINT) {
+    header.flags |= data_loading::binary::FLAG_FIXED_POINT;
+    header.price_decimals = static_cast<std::uint16_t>(scale.price_decimals());
+    header.amount_decimals =
+        static_cast<std::uint16_t>(scale.amount_decimals());
+  }
+}
+
+/// Returns the scale stored in a header.
+common_types::InstrumentScale
+read_scale(const data_loading::binary::FileHeader &header) {
+  if (header.flags & data_loading::binary::FLAG_FIXED_POINT) {
+    return {header.price_decimals, header.amount_decimals};
+  }
+  return {};
+}
+
+/// Validates header and total size; returns pointer to the first column.
+const char *check_file(const data_loading::MappedFile &file,
+                       const std::string &filename, std::uint32_t magic,
+                       data_loading::binary::FileHeader &header,
+                       std::size_t row_bytes) {
+  if (file.size() < sizeof(header)) {
+    throw std::runtime_error("Binary file is truncated: " + filename);
+  }
+  std::memcpy(&header, file.data(), sizeof(header));
+  if (header.magic != magic) {
+    throw std::runtime_error("Unexpected binary file type: " + filename);
+  }
+  if (header.version != data_loading::binary::FORMAT_VERSION) {
+    throw std::runtime_error("Unsupported binary format version: " +
+                             filename);
+  }
+  const bool fixed_point =
+      (header.flags & data_loading::binary::FLAG_FIXED_POINT) != 0;
+  if (fixed_point != common_types::FIXED_POINT) {
+    throw std::runtime_error(
+        "Binary file was written with a different price representation "
+        "(HFT_TASK_FIXED_POINT): " +
+        filename);
+  }
+  const std::size_t per_row =
+      row_bytes + header.depth * 2 *
+                      (sizeof(common_types::Price) +
+                       sizeof(common_types::Amount));
+  // Divided rather than multiplied: a malformed row count must not wrap.
+  if (header.rows > (file.size() - sizeof(header)) / per_row) {
+    throw std::runtime_error("Binary file is truncated: " + filename);
+  }
+  return file.data() + sizeof(header);
+}
+} // namespace
+
+namespace data_loading {
+namespace binary {
+void write_lob(const std::string &filename,
+               const std::vector<raw_data::LOBData> &lob_data,
+               const common_types::InstrumentScale &scale) {
+  std::size_t depth = 0;
+  for (const auto &snapshot : lob_data) {
+    depth = std::max({depth, snapshot.asks.size(), snapshot.bids.size()});
+  }
+
+  FileHeader header;
+  header.magic = LOB_MAGIC;
+  header.version = FORMAT_VERSION;
+  header.depth = static_cast<std::uint32_t>(depth);
+  header.rows = lob_data.size();
+  set_scale(header, scale);
+
+  auto out = open_output(filename);
+  write_values(out, &header, 1);
+
+  for (const auto &snapshot : lob_data) {
+    const std::int64_t ts = snapshot.local_timestamp;
+    write_values(out, &ts, 1);
+  }
+  for (const auto &snapshot : lob_data) {
+    const auto count = static_cast<std::uint32_t>(snapshot.asks.size());
+    write_values(out, &count, 1);
+  }
+  for (const auto &snapshot : lob_data) {
+    const auto count = static_cast<std::uint32_t>(snapshot.bids.size());
+    write_values(out, &count, 1);
+  }
+
+  using common_types::Amount;
+  using common_types::Price;
+  write_level_column<Price>(
+      out, lob_data, depth, [](const auto &s, auto &row) {
+        for (std::size_t i = 0; i < s.asks.size(); ++i)
+          row[i] = s.asks[i].price;
+      });
+  write_level_column<Amount>(
+      out, lob_data, depth, [](const auto &s, auto &row) {
+        for (std::size_t i = 0; i < s.asks.size(); ++i)
+          row[i] = s.asks[i].amount;
+      });
+  write_level_column<Price>(
+      out, lob_data, depth, [](const auto &s, auto &row) {
+        for (std::size_t i = 0; i < s.bids.size(); ++i)
+          row[i] = s.bids[i].price;
+      });
+  write_level_column<Amount>(
+      out, lob_data, depth, [](const auto &s, auto &row) {
+        for (std::size_t i = 0; i < s.bids.size(); ++i)
+          row[i] = s.bids[i].amount;
+      });
+
+  if (!out) {
+    throw std::runtime_error("Failed to write file: " + filename);
+  }
+  logging::Logger::debug("Binary LOB written: ", lob_data.size(),
+                         " rows, depth ", depth);
+}
+
+void write_trades(const std::string &filename,
+                  const std::vector<raw_data::TradeData> &trades,
+                  const common_types::InstrumentScale &scale) {
+  FileHeader header;
+  header.magic = TRADES_MAGIC;
+  header.version = FORMAT_VERSION;
+  header.rows = trades.size();
+  set_scale(header, scale);
+
+  auto out = open_output(filename);
+  write_values(out, &header, 1);
+
+  for (const auto &trade : trades) {
+    const std::int64_t ts = trade.local_timestamp;
+    write_values(out, &ts, 1);
+  }
+  for (const auto &trade : trades) {
+    write_values(out, &trade.price, 1);
+  }
+  for (const auto &trade : trades) {
+    write_values(out, &trade.amount, 1);
+  }
+  for (const auto &trade : trades) {
+    const auto side = static_cast<std::int8_t>(trade.side);
+    write_values(out, &side, 1);
+  }
+
+  if (!out) {
+    throw std::runtime_error("Failed to write file: " + filename);
+  }
+  logging::Logger::debug("Binary trades written: ", trades.size(), " rows");
+}
+
+bool has_magic(const std::string &filename, std::uint32_t magic) {
+  std::ifstream in(filename, std::ios::binary);
+  std::uint32_t file_magic = 0;
+  in.read(reinterpret_cast<char *>(&file_magic), sizeof(file_magic));
+  return in && file_magic == magic;
+}
+} // namespace binary
+
+BinaryLOBFile::BinaryLOBFile(const std::string &filename) : file_(filename) {
+  binary::FileHeader header;
+  const char *cur =
+      check_file(file_, filename, binary::LOB_MAGIC, header,
+                 sizeof(std::int64_t) + 2 * sizeof(std::uint32_t));
+  rows_ = header.rows;
+  depth_ = header.depth;
+  scale_ = read_scale(header);
+
+  const std::size_t levels = rows_ * depth_;
+  timestamps_ = reinterpret_cast<const std::int64_t *>(cur);
+  cur += rows_ * sizeof(std::int64_t);
+  ask_counts_ = reinterpret_cast<const std::uint32_t *>(cur);
+  cur += rows_ * sizeof(std::uint32_t);
+  bid_counts_ = reinterpret_cast<const std::uint32_t *>(cur);
+  cur += rows_ * sizeof(std::uint32_t);
+  ask_prices_ = reinterpret_cast<const common_types::Price *>(cur);
+  cur += levels * sizeof(common_types::Price);
+  ask_amounts_ = reinterpret_cast<const common_types::Amount *>(cur);
+  cur += levels * sizeof(common_types::Amount);
+  bid_prices_ = reinterpret_cast<const common_types::Price *>(cur);
+  cur += levels * sizeof(common_types::Price);
+  bid_amounts_ = reinterpret_cast<const common_types::Amount *>(cur);
+}
+
+void BinaryLOBFile::load(std::size_t i, raw_data::LOBData &out) const {
+  out.local_timestamp = timestamps_[i];
+
+  // Files written by a build with a larger MAX_LOB_DEPTH keep their top
+  // levels only.
+  const std::size_t base = i * depth_;
+  const std::size_t asks =
+      std::min<std::size_t>(ask_counts_[i], raw_data::MAX_LOB_DEPTH);
+  const std::size_t bids =
+      std::min<std::size_t>(bid_counts_[i], raw_data::MAX_LOB_DEPTH);
+  out.asks.assign(ask_prices_ + base, ask_amounts_ + base, asks);
+  out.bids.assign(bid_prices_ + base, bid_amounts_ + base, bids);
+}
+
+BinaryTradesFile::BinaryTradesFile(const std::string &filename)
+    : file_(filename) {
+  binary::FileHeader header;
+  const char *cur = check_file(file_, filename, binary::TRADES_MAGIC, header,
+                               sizeof(std::int64_t) +
+                                   sizeof(common_types::Price) +
+                                   sizeof(common_types::Amount) +
+                                   sizeof(std::int8_t));
+  rows_ = header.rows;
+  scale_ = read_scale(header);
+
+  timestamps_ = reinterpret_cast<const std::int64_t *>(cur);
+  cur += rows_ * sizeof(std::int64_t);
+  prices_ = reinterpret_cast<const common_types::Price *>(cur);
+  cur += rows_ * sizeof(common_types::Price);
+  amounts_ = reinterpret_cast<const common_types::Amount *>(cur);
+  cur += rows_ * sizeof(common_types::Amount);
+  sides_ = reinterpret_cast<const std::int8_t *>(cur);
+}
+
+raw_data::TradeData BinaryTradesFile::trade(std::size_t i) const noexcept {
+  return {timestamps_[i], static_cast<common_types::Side>(sides_[i]),
+          prices_[i], amounts_[i]};
+}
+
+std::vector<raw_data::TradeData> BinaryTradesFile::to_vector() const {
+  std::vector<raw_data::TradeData> trades;
+  trades.reserve(rows_);
+  for (std::size_t i = 0; i < rows_; ++i) {
+    trades.push_back(trade(i));
+  }
+  return trades;
+}
+} // namespace data_loading
@@ -0,0 +1,104 @@
+#include "execution/book_features.hpp"
+#include "execution/depth_kernels.hpp"
+#include <algorithm>
+
+namespace {
+/// Snapshot unbound features describe.
+const raw_data::LOBData &empty_book() {
+  static const raw_data::LOBData book{};
+  return book;
+}
+} // namespace
+
+namespace execution {
+BookFeatures::BookFeatures(const common_types::InstrumentScale &scale)
+    : data_(&empty_book()), scale_(scale) {}
+
+BookFeatures::BookFeatures(const raw_data::LOBData &data,
+                           const common_types::InstrumentScale &scale)
+    : data_(&data), scale_(scale) {}
+
+common_types::Amount
+BookFeatures::ask_depth(std::size_t levels) const noexcept {
+  const Prefix &sums = prefix(data_->asks, ask_prefix_, ASK_DEPTH);
+  return sums[std::min(levels, data_->asks.size())];
+}
+
+common_types::Amount
+BookFeatures::bid_depth(std::size_t levels) const noexcept {
+  const Prefix &sums = prefix(data_->bids, bid_prefix_, BID_DEPTH);
+  return sums[std::min(levels, data_->bids.size())];
+}
+
+double BookFeatures::imbalance(std::size_t levels) const noexcept {
+  const double bids = static_cast<double>(bid_depth(levels));
+  const double asks = static_cast<double>(ask_depth(levels));
+  if (bids + asks <= 0.0) {
+    return 0.0;
+  }
+  return (bids - asks) / (bids + asks);
+}
+
+std::size_t BookFeatures::levels_within(common_types::Price limit,
+                                        common_types::Side taker) const
+    noexcept {
+  return kernels::levels_within(book_side(taker), limit, taker);
+}
+
+std::size_t BookFeatures::exhaust_level(common_types::Side taker,
+                                        std::size_t levels,
+                                        common_types::Amount amount) const
+    noexcept {
+  const bool buy = taker == common_types::Side::Buy;
+  const std::uint8_t flag = buy ? ASK_DEPTH : BID_DEPTH;
+  if ((valid_ & flag) == 0) {
+    return kernels::exhaust_level(book_side(taker), levels, amount);
+  }
+  // sums[i + 1] is the depth through level i.
+  const Prefix &sums = buy ? ask_prefix_ : bid_prefix_;
+  const auto *first = sums.data() + 1;
+  return static_cast<std::size_t>(
+      std::lower_bound(first, first + levels, amount) - first);
+}
+
+const BookFeatures::Top &BookFeatures::top() const noexcept {
+  if ((valid_ & TOP) != 0) {
+    return top_;
+  }
+
+  const auto &bids = data_->bids;
+  const auto &asks = data_->asks;
+  top_.best_bid = bids.empty() ? .0 : scale_.from_price(bids.prices()[0]);
+  top_.best_ask = asks.empty() ? .0 : scale_.from_price(asks.prices()[0]);
+  top_.mid = (top_.best_bid + top_.best_ask) / 2.0;
+  top_.spread = two_sided() ? top_.best_ask - top_.best_bid : .0;
+  top_.microprice = top_.mid;
+  if (two_sided()) {
+    const double bid_amount = scale_.from_amount(bids.amounts()[0]);
+    const double ask_amount = scale_.from_amount(asks.amounts()[0]);
+    if (bid_amount + ask_amount > 0.0) {
+      top_.microprice =
+          (top_.best_bid * ask_amount + top_.best_ask * bid_amount) /
+          (bid_amount + ask_amount);
+    }
+  }
+  valid_ |= TOP;
+  return top_;
+}
+
+const BookFeatures::Prefix &
+BookFeatures::prefix(const raw_data::BookSide &side, Prefix &sums,
+                     std::uint8_t flag) const noexcept {
+  if ((valid_ & flag) != 0) {
+    return sums;
+  }
+
+  const common_types::Amount *amounts = side.amounts();
+  sums[0] = 0;
+  for (std::size_t i = 0; i < side.size(); ++i) {
+    sums[i + 1] = sums[i] + amounts[i];
+  }
+  valid_ |= flag;
+  return sums;
+}
+} // namespace execution
@@ -0,0 +1,160 @@
+#include "data_loader/byte_source.hpp"
+#include "logging.hpp"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#ifdef HFT_TASK_WITH_ZLIB
+#include <zlib.h>
+#endif
+
+namespace data_loading {
+FileByteSource::FileByteSource(const std::string &filename)
+    : file_(filename, std::ios::binary) {
+  if (!file_.is_open()) {
+    throw std::runtime_error("Cannot open file: " + filename);
+  }
+}
+
+std::size_t FileByteSource::read(char *dst, std::size_t size) {
+  file_.read(dst, static_cast<std::streamsize>(size));
+  return static_cast<std::size_t>(file_.gcount());
+}
+
+bool FileByteSource::seek(std::size_t offset) {
+  file_.clear();
+  file_.seekg(static_cast<std::streamoff>(offset));
+  return static_cast<bool>(file_);
+}
+
+#ifdef HFT_TASK_WITH_ZLIB
+GzipByteSource::GzipByteSource(const std::string &filename) {
+  gzFile gz_file = gzopen(filename.c_str(), "rb");
+  if (gz_file == nullptr) {
+    throw std::runtime_error("Cannot open file: " + filename);
+  }
+  gzbuffer(gz_file, BLOCK_SIZE);
+
+  inflater_ = std::thread([this, gz_file]() { inflate(gz_file); });
+}
+
+void GzipByteSource::inflate(void *gz_file) {
+  auto file = static_cast<gzFile>(gz_file);
+  try {
+    while (true) {
+      Block *block = nullptr;
+      while ((block = ring_.write_slot()) == nullptr) {
+        if (stop_.load(std::memory_order_relaxed)) {
+          gzclose(file);
+          return;
+        }
+        std::this_thread::yield();
+      }
+      block->data.resize(BLOCK_SIZE);
+
+      const int read =
+          gzread(file, block->data.data(), static_cast<unsigned>(BLOCK_SIZE));
+      if (read < 0) {
+        int err = 0;
+        throw std::runtime_error(std::string("gzip decompression failed: ") +
+                                 gzerror(file, &err));
+      }
+      if (read == 0) {
+        break;
+      }
+      block->size = static_cast<std::size_t>(read);
+      ring_.commit_write();
+    }
+  } catch (...) {
+    error_ = std::current_exception();
+  }
+  gzclose(file);
+  done_.store(true, std::memory_order_release);
+}
+#else
+GzipByteSource::GzipByteSource(const std::string &filename) {
+  throw std::runtime_error("Cannot read gzip file " + filename +
+                           ": hft_task was built without zlib");
+}
+
+void GzipByteSource::inflate(void *) {}
+#endif
+
+GzipByteSource::~GzipByteSource() {
+  stop_.store(true, std::memory_order_relaxed);
+  if (inflater_.joinable()) {
+    inflater_.join();
+  }
+}
+
+std::size_t GzipByteSource::read(char *dst, std::size_t size) {
+  std::size_t copied = 0;
+  while (copied < size) {
+    if (current_ == nullptr) {
+      current_ = ring_.read_slot();
+      if (current_ == nullptr) {
+        if (done_.load(std::memory_order_acquire)) {
+          // The inflater may have published between the two checks.
+          current_ = ring_.read_slot();
+          if (current_ == nullptr) {
+            if (error_) {
+              std::rethrow_exception(error_);
+            }
+            break;
+          }
+        } else if (copied > 0) {
+          break;
+        } else {
+          std::this_thread::yield();
+          continue;
+        }
+      }
+      offset_ = 0;
+    }
+
+    const std::size_t chunk =
+        std::min(size - copied, current_->size - offset_);
+    std::memcpy(dst + copied, current_->data.data() + offset_, chunk);
+    copied += chunk;
+    offset_ += chunk;
+
+    if (offset_ == current_->size) {
+      current_ = nullptr;
+      ring_.release_read();
+    }
+  }
+  return copied;
+}
+
+ByteSourceStreamBuf::ByteSourceStreamBuf(ByteSourceAbstract::UPtr &&source,
+                                         std::size_t buffer_size)
+    : source_(std::move(source)), buffer_(buffer_size) {
+  setg(buffer_.data(), buffer_.data(), buffer_.data());
+}
+
+ByteSourceStreamBuf::int_type ByteSourceStreamBuf::underflow() {
+  if (gptr() < egptr()) {
+    return traits_type::to_int_type(*gptr());
+  }
+  const std::size_t read = source_->read(buffer_.data(), buffer_.size());
+  if (read == 0) {
+    return traits_type::eof();
+  }
+  setg(buffer_.data(), buffer_.data(), buffer_.data() + read);
+  return traits_type::to_int_type(*gptr());
+}
+
+bool is_gzip_file(const std::string &filename) {
+  std::ifstream in(filename, std::ios::binary);
+  unsigned char magic[2] = {0, 0};
+  in.read(reinterpret_cast<char *>(magic), sizeof(magic));
+  return in && magic[0] == 0x1f && magic[1] == 0x8b;
+}
+
+ByteSourceAbstract::UPtr open_byte_source(const std::string &filename) {
+  if (is_gzip_file(filename)) {
+    logging::Logger::debug("Reading gzip compressed input: ", filename);
+    return std::make_unique<GzipByteSource>(filename);
+  }
+  return std::make_unique<FileByteSource>(filename);
+}
+} // namespace data_loading
@@ -0,0 +1,42 @@
+#include "data_loader/csv_cursor.hpp"
+#include <filesystem>
+
+namespace data_loading {
+CSVCursor::CSVCursor(const std::string &filename, std::size_t buffer_size)
+    : filename_(filename), buffer_size_(buffer_size),
+      reader_(filename, buffer_size) {
+  std::string_view header;
+  reader_.next_line(header);
+
+  const std::string index_filename = TimestampIndex::path_for(filename);
+  if (std::filesystem::exists(index_filename)) {
+    auto index = TimestampIndex::load(index_filename);
+    if (index.matches(filename)) {
+      index_ = std::move(index);
+    } else {
+      logging::Logger::debug("Ignoring stale timestamp index: ",
+                             index_filename);
+    }
+  }
+}
+
+bool CSVCursor::reposition(long long timestamp) {
+  if (!index_.empty()) {
+    if (!reader_.seek(index_.offset_before(timestamp))) {
+      return false;
+    }
+  } else if (has_pending_ || timestamp <= last_timestamp_) {
+    // Rows at or after `timestamp` may already be behind the reader.
+    rewind();
+  }
+  has_pending_ = false;
+  return true;
+}
+
+void CSVCursor::rewind() {
+  reader_ = LineReader(filename_, buffer_size_);
+  std::string_view header;
+  reader_.next_line(header);
+  last_timestamp_ = std::numeric_limits<long long>::min();
+}
+} // namespace data_loading
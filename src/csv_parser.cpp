@@ -1,9 +1,11 @@
 #include "data_loader/csv_parser.hpp"
+#include "data_loader/byte_source.hpp"
 #include "data_loader/csv.h"
 #include "logging.hpp"
 #include "types.hpp"
+#include <algorithm>
 #include <cctype>
-#include <fstream>
+#include <istream>
 #include <iostream>
 #include <sstream>
 #include <stdexcept>
@@ -27,10 +29,8 @@ std::vector<raw_data::LOBData>
 CSVParser::parse_lob(const std::string &filename) {
   std::vector<raw_data::LOBData> lob_data;
 
-  std::ifstream file(filename);
-  if (!file.is_open()) {
-    throw std::runtime_error("Cannot open file: " + filename);
-  }
+  ByteSourceStreamBuf buffer(open_byte_source(filename));
+  std::istream file(&buffer);
 
   std::string line;
   std::getline(file, line);
@@ -56,7 +56,9 @@ CSVParser::parse_lob(const std::string &filename) {
       continue;
     }
 
-    for (int i = 0; i < lob_depth_level_; ++i) {
+    const int depth =
+        std::min(lob_depth_level_, static_cast<int>(raw_data::MAX_LOB_DEPTH));
+    for (int i = 0; i < depth; ++i) {
       double ask_price = 0.0, ask_amount = 0.0, bid_price = 0.0,
              bid_amount = 0.0;
 
@@ -83,11 +85,15 @@ CSVParser::parse_lob(const std::string &filename) {
         continue;
       }
 
-      if (ask_price > 0 && ask_amount > 0) {
-        entry.asks.push_back({ask_price, ask_amount});
+      const raw_data::OrderBookEntry ask{scale_.to_price(ask_price),
+                                         scale_.to_amount(ask_amount)};
+      const raw_data::OrderBookEntry bid{scale_.to_price(bid_price),
+                                         scale_.to_amount(bid_amount)};
+      if (ask.price > 0 && ask.amount > 0) {
+        entry.asks.push_back(ask);
       }
-      if (bid_price > 0 && bid_amount > 0) {
-        entry.bids.push_back({bid_price, bid_amount});
+      if (bid.price > 0 && bid.amount > 0) {
+        entry.bids.push_back(bid);
       }
     }
 
@@ -102,10 +108,8 @@ std::vector<raw_data::TradeData>
 CSVParser::parse_trades(const std::string &filename) {
   std::vector<raw_data::TradeData> trades;
 
-  std::ifstream file(filename);
-  if (!file.is_open()) {
-    throw std::runtime_error("Cannot open file: " + filename);
-  }
+  ByteSourceStreamBuf buffer(open_byte_source(filename));
+  std::istream file(&buffer);
 
   std::string line;
   std::getline(file, line);
@@ -139,7 +143,7 @@ CSVParser::parse_trades(const std::string &filename) {
 
     std::getline(ss, cell, ',');
     try {
-      trade.price = std::stod(cell);
+      trade.price = scale_.to_price(std::stod(cell));
     } catch (const std::exception &e) {
       logging::Logger::debug("Error parsing price at line ", line_count, ": ",
                              cell);
@@ -148,7 +152,7 @@ CSVParser::parse_trades(const std::string &filename) {
 
     std::getline(ss, cell, ',');
     try {
-      trade.amount = std::stod(cell);
+      trade.amount = scale_.to_amount(std::stod(cell));
     } catch (const std::exception &e) {
       logging::Logger::debug("Error parsing amount at line ", line_count, ":",
                              cell);
@@ -0,0 +1,178 @@
+#include "data_loader/delta_lob_store.hpp"
+#include "logging.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+inline bool same_entry(const raw_data::OrderBookEntry &lhs,
+                       const raw_data::OrderBookEntry &rhs) {
+  return lhs.price == rhs.price && lhs.amount == rhs.amount;
+}
+
+/// Counts levels of `side` that differ from `prev_side`.
+template <typename Side>
+std::size_t count_changes(const Side &prev_side, const Side &side) {
+  std::size_t changes = 0;
+  for (std::size_t l = 0; l < side.size(); ++l) {
+    if (l >= prev_side.size() || !same_entry(prev_side[l], side[l])) {
+      ++changes;
+    }
+  }
+  return changes;
+}
+} // namespace
+
+namespace data_loading {
+DeltaLOBStore::DeltaLOBStore(std::size_t keyframe_interval)
+    : keyframe_interval_(keyframe_interval > 0 ? keyframe_interval : 1) {}
+
+DeltaLOBStore DeltaLOBStore::build(
+    const std::vector<raw_data::LOBData> &lob_data,
+    std::size_t keyframe_interval) {
+  DeltaLOBStore store(keyframe_interval);
+  store.records_.reserve(lob_data.size());
+  for (const auto &snapshot : lob_data) {
+    store.append(snapshot);
+  }
+  store.deltas_.shrink_to_fit();
+  store.keyframe_levels_.shrink_to_fit();
+  logging::Logger::debug("[DELTA] Encoded ", lob_data.size(),
+                         " snapshots into ", store.memory_usage(), " bytes");
+  return store;
+}
+
+void DeltaLOBStore::append(const raw_data::LOBData &snapshot) {
+  if (snapshot.asks.size() > UINT16_MAX || snapshot.bids.size() > UINT16_MAX) {
+    throw std::invalid_argument("DeltaLOBStore: book is too deep");
+  }
+  if (deltas_.size() + snapshot.asks.size() + snapshot.bids.size() >
+          UINT32_MAX ||
+      keyframe_levels_.size() + snapshot.asks.size() + snapshot.bids.size() >
+          UINT32_MAX) {
+    throw std::length_error("DeltaLOBStore: too many levels stored");
+  }
+
+  const std::size_t changes = count_changes(last_.asks, snapshot.asks) +
+                              count_changes(last_.bids, snapshot.bids);
+  const std::size_t book_levels = snapshot.asks.size() + snapshot.bids.size();
+
+  if (records_.empty() || since_keyframe_ + 1 >= keyframe_interval_ ||
+      changes * 2 > book_levels) {
+    append_keyframe(snapshot);
+    return;
+  }
+
+  Record record{};
+  record.local_timestamp = snapshot.local_timestamp;
+  record.offset = static_cast<std::uint32_t>(deltas_.size());
+  record.delta_count = static_cast<std::uint16_t>(changes);
+  record.ask_count = static_cast<std::uint16_t>(snapshot.asks.size());
+  record.bid_count = static_cast<std::uint16_t>(snapshot.bids.size());
+  record.keyframe = false;
+
+  push_deltas(last_.asks, snapshot.asks, false);
+  push_deltas(last_.bids, snapshot.bids, true);
+
+  records_.push_back(record);
+  last_ = snapshot;
+  ++since_keyframe_;
+}
+
+template <typename Side>
+void DeltaLOBStore::push_deltas(const Side &prev_side, const Side &side,
+                                bool is_bid) {
+  for (std::size_t l = 0; l < side.size(); ++l) {
+    if (l >= prev_side.size() || !same_entry(prev_side[l], side[l])) {
+      deltas_.push_back({side[l], static_cast<std::uint16_t>(l), is_bid});
+    }
+  }
+}
+
+void DeltaLOBStore::append_keyframe(const raw_data::LOBData &snapshot) {
+  Record record{};
+  record.local_timestamp = snapshot.local_timestamp;
+  record.offset = static_cast<std::uint32_t>(keyframe_levels_.size());
+  record.delta_count = 0;
+  record.ask_count = static_cast<std::uint16_t>(snapshot.asks.size());
+  record.bid_count = static_cast<std::uint16_t>(snapshot.bids.size());
+  record.keyframe = true;
+
+  keyframe_levels_.insert(keyframe_levels_.end(), snapshot.asks.begin(),
+                          snapshot.asks.end());
+  keyframe_levels_.insert(keyframe_levels_.end(), snapshot.bids.begin(),
+                          snapshot.bids.end());
+
+  records_.push_back(record);
+  last_ = snapshot;
+  since_keyframe_ = 0;
+}
+
+std::size_t DeltaLOBStore::memory_usage() const noexcept {
+  return records_.capacity() * sizeof(Record) +
+         deltas_.capacity() * sizeof(LevelDelta) +
+         keyframe_levels_.capacity() * sizeof(raw_data::OrderBookEntry);
+}
+
+void DeltaLOBStore::advance(std::size_t i, raw_data::LOBData &book) const {
+  const Record &record = records_[i];
+  book.local_timestamp = record.local_timestamp;
+
+  if (record.keyframe) {
+    const auto *levels = keyframe_levels_.data() + record.offset;
+    book.asks.assign(levels, levels + record.ask_count);
+    book.bids.assign(levels + record.ask_count,
+                     levels + record.ask_count + record.bid_count);
+    return;
+  }
+
+  book.asks.resize(record.ask_count);
+  book.bids.resize(record.bid_count);
+  const auto *delta = deltas_.data() + record.offset;
+  for (std::size_t d = 0; d < record.delta_count; ++d, ++delta) {
+    auto &side = delta->is_bid ? book.bids : book.asks;
+    side.set(delta->level, delta->entry);
+  }
+}
+
+void DeltaLOBStore::snapshot_at(std::size_t i, raw_data::LOBData &out) const {
+  std::size_t keyframe = i;
+  while (!records_[keyframe].keyframe) {
+    --keyframe;
+  }
+  for (std::size_t j = keyframe; j <= i; ++j) {
+    advance(j, out);
+  }
+}
+
+std::size_t DeltaLOBStore::lower_bound(long long timestamp) const noexcept {
+  const auto it = std::lower_bound(
+      records_.begin(), records_.end(), timestamp,
+      [](const Record &record, long long ts) {
+        return record.local_timestamp < ts;
+      });
+  return static_cast<std::size_t>(it - records_.begin());
+}
+
+DeltaDataSource::DeltaDataSource(std::shared_ptr<const DeltaLOBStore> store)
+    : store_(std::move(store)) {}
+
+const raw_data::LOBData *DeltaDataSource::next() {
+  if (store_ == nullptr || cursor_ >= store_->size()) {
+    return nullptr;
+  }
+  store_->advance(cursor_++, book_);
+  return &book_;
+}
+
+bool DeltaDataSource::seek(long long timestamp) {
+  if (store_ == nullptr) {
+    return false;
+  }
+  cursor_ = store_->lower_bound(timestamp);
+  if (cursor_ > 0 && cursor_ < store_->size()) {
+    // next() applies the deltas of cursor_ on top of the previous snapshot.
+    store_->snapshot_at(cursor_ - 1, book_);
+  }
+  return true;
+}
+} // namespace data_loading
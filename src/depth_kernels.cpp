@@ -0,0 +1,303 @@
+#include "execution/depth_kernels.hpp"
+#include <bit>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace execution::kernels {
+namespace {
+using common_types::Amount;
+using common_types::Notional;
+using common_types::Price;
+
+/// True if `price` is worse than `limit` for an order walking the book.
+inline bool beyond(Price price, Price limit, bool buy) noexcept {
+  return buy ? price > limit : price < limit;
+}
+
+// Every configuration below provides, for one block of LANES levels:
+//  - beyond_mask: bit i set if level i is priced beyond the limit;
+//  - block_sum:   sum of the amounts;
+//  - block_dot:   sum of price * amount;
+//  - reach_mask:  bit i set if `running` plus the amounts up to level i
+//                 reaches `target`; `running` is advanced past the block.
+
+#if defined(__AVX2__) && defined(HFT_TASK_FIXED_POINT)
+
+constexpr std::size_t LANES = 4;
+
+inline __m256i load(const std::int64_t *p) noexcept {
+  return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+}
+
+inline unsigned mask_of(__m256i v) noexcept {
+  return static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(v)));
+}
+
+inline unsigned beyond_mask(const Price *p, Price limit, bool buy) noexcept {
+  const __m256i v = load(p);
+  const __m256i lim = _mm256_set1_epi64x(limit);
+  return mask_of(buy ? _mm256_cmpgt_epi64(v, lim)
+                     : _mm256_cmpgt_epi64(lim, v));
+}
+
+inline Amount block_sum(const Amount *a) noexcept {
+  const __m256i v = load(a);
+  const __m128i s = _mm_add_epi64(_mm256_castsi256_si128(v),
+                                  _mm256_extracti128_si256(v, 1));
+  return _mm_cvtsi128_si64(s) + _mm_extract_epi64(s, 1);
+}
+
+inline Notional block_dot(const Price *p, const Amount *a) noexcept {
+  Notional sum = 0;
+  for (std::size_t i = 0; i < LANES; ++i) {
+    sum += common_types::notional(p[i], a[i]);
+  }
+  return sum;
+}
+
+inline unsigned reach_mask(const Amount *a, Amount &running,
+                           Amount target) noexcept {
+  const __m256i zero = _mm256_setzero_si256();
+  __m256i v = load(a);
+  v = _mm256_add_epi64(
+      v, _mm256_blend_epi32(zero, _mm256_set1_epi64x(running), 0x03));
+  v = _mm256_add_epi64(
+      v, _mm256_blend_epi32(
+             _mm256_permute4x64_epi64(v, _MM_SHUFFLE(2, 1, 0, 0)), zero, 0x03));
+  v = _mm256_add_epi64(
+      v, _mm256_blend_epi32(
+             _mm256_permute4x64_epi64(v, _MM_SHUFFLE(1, 0, 0, 0)), zero, 0x0F));
+  running = _mm256_extract_epi64(v, 3);
+  return ~mask_of(_mm256_cmpgt_epi64(_mm256_set1_epi64x(target), v)) & 0xF;
+}
+
+#elif defined(__AVX2__)
+
+constexpr std::size_t LANES = 4;
+
+inline unsigned beyond_mask(const Price *p, Price limit, bool buy) noexcept {
+  const __m256d v = _mm256_loadu_pd(p);
+  const __m256d lim = _mm256_set1_pd(limit);
+  return static_cast<unsigned>(
+      _mm256_movemask_pd(buy ? _mm256_cmp_pd(v, lim, _CMP_GT_OQ)
+                             : _mm256_cmp_pd(v, lim, _CMP_LT_OQ)));
+}
+
+inline double horizontal_sum(__m256d v) noexcept {
+  const __m128d s =
+      _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+  return _mm_cvtsd_f64(_mm_add_sd(s, _mm_unpackhi_pd(s, s)));
+}
+
+inline Amount block_sum(const Amount *a) noexcept {
+  return horizontal_sum(_mm256_loadu_pd(a));
+}
+
+inline Notional block_dot(const Price *p, const Amount *a) noexcept {
+  return horizontal_sum(_mm256_mul_pd(_mm256_loadu_pd(p), _mm256_loadu_pd(a)));
+}
+
+inline unsigned reach_mask(const Amount *a, Amount &running,
+                           Amount target) noexcept {
+  // Running total goes into lane 0 first, so lanes 0 and 1 add in the same
+  // order as a sequential loop.
+  const __m256d zero = _mm256_setzero_pd();
+  __m256d v = _mm256_loadu_pd(a);
+  v = _mm256_add_pd(v, _mm256_blend_pd(zero, _mm256_set1_pd(running), 0x1));
+  v = _mm256_add_pd(
+      v, _mm256_blend_pd(_mm256_permute4x64_pd(v, _MM_SHUFFLE(2, 1, 0, 0)),
+                         zero, 0x1));
+  v = _mm256_add_pd(
+      v, _mm256_blend_pd(_mm256_permute4x64_pd(v, _MM_SHUFFLE(1, 0, 0, 0)),
+                         zero, 0x3));
+  const __m128d high = _mm256_extractf128_pd(v, 1);
+  running = _mm_cvtsd_f64(_mm_unpackhi_pd(high, high));
+  return static_cast<unsigned>(_mm256_movemask_pd(
+      _mm256_cmp_pd(v, _mm256_set1_pd(target), _CMP_GE_OQ)));
+}
+
+#elif defined(__SSE4_2__) && defined(HFT_TASK_FIXED_POINT)
+
+constexpr std::size_t LANES = 2;
+
+inline __m128i load(const std::int64_t *p) noexcept {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+}
+
+inline unsigned mask_of(__m128i v) noexcept {
+  return static_cast<unsigned>(_mm_movemask_pd(_mm_castsi128_pd(v)));
+}
+
+inline unsigned beyond_mask(const Price *p, Price limit, bool buy) noexcept {
+  const __m128i v = load(p);
+  const __m128i lim = _mm_set1_epi64x(limit);
+  return mask_of(buy ? _mm_cmpgt_epi64(v, lim) : _mm_cmpgt_epi64(lim, v));
+}
+
+inline Amount block_sum(const Amount *a) noexcept { return a[0] + a[1]; }
+
+inline Notional block_dot(const Price *p, const Amount *a) noexcept {
+  return common_types::notional(p[0], a[0]) +
+         common_types::notional(p[1], a[1]);
+}
+
+inline unsigned reach_mask(const Amount *a, Amount &running,
+                           Amount target) noexcept {
+  __m128i v = _mm_add_epi64(load(a), _mm_cvtsi64_si128(running));
+  v = _mm_add_epi64(v, _mm_slli_si128(v, 8));
+  running = _mm_cvtsi128_si64(_mm_unpackhi_epi64(v, v));
+  return ~mask_of(_mm_cmpgt_epi64(_mm_set1_epi64x(target), v)) & 0x3;
+}
+
+#elif defined(__SSE2__) && !defined(HFT_TASK_FIXED_POINT)
+
+constexpr std::size_t LANES = 2;
+
+inline unsigned beyond_mask(const Price *p, Price limit, bool buy) noexcept {
+  const __m128d v = _mm_loadu_pd(p);
+  const __m128d lim = _mm_set1_pd(limit);
+  return static_cast<unsigned>(_mm_movemask_pd(
+      buy ? _mm_cmpgt_pd(v, lim) : _mm_cmplt_pd(v, lim)));
+}
+
+inline double horizontal_sum(__m128d v) noexcept {
+  return _mm_cvtsd_f64(_mm_add_sd(v, _mm_unpackhi_pd(v, v)));
+}
+
+inline Amount block_sum(const Amount *a) noexcept {
+  return horizontal_sum(_mm_loadu_pd(a));
+}
+
+inline Notional block_dot(const Price *p, const Amount *a) noexcept {
+  return horizontal_sum(_mm_mul_pd(_mm_loadu_pd(p), _mm_loadu_pd(a)));
+}
+
+inline unsigned reach_mask(const Amount *a, Amount &running,
+                           Amount target) noexcept {
+  // Two lanes add in exactly the order of a sequential loop.
+  __m128d v = _mm_add_pd(_mm_loadu_pd(a), _mm_set_sd(running));
+  v = _mm_add_pd(v, _mm_castsi128_pd(_mm_slli_si128(_mm_castpd_si128(v), 8)));
+  running = _mm_cvtsd_f64(_mm_unpackhi_pd(v, v));
+  return static_cast<unsigned>(
+      _mm_movemask_pd(_mm_cmpge_pd(v, _mm_set1_pd(target))));
+}
+
+#else
+
+constexpr std::size_t LANES = 1;
+
+inline unsigned beyond_mask(const Price *p, Price limit, bool buy) noexcept {
+  return beyond(*p, limit, buy) ? 1U : 0U;
+}
+
+inline Amount block_sum(const Amount *a) noexcept { return *a; }
+
+inline Notional block_dot(const Price *p, const Amount *a) noexcept {
+  return common_types::notional(*p, *a);
+}
+
+inline unsigned reach_mask(const Amount *a, Amount &running,
+                           Amount target) noexcept {
+  running += *a;
+  return running >= target ? 1U : 0U;
+}
+
+#endif
+
+/// Sums price * amount over the first `levels` levels.
+Notional dot(const raw_data::BookSide &side, std::size_t levels) noexcept {
+  const Price *prices = side.prices();
+  const Amount *amounts = side.amounts();
+  Notional sum = 0;
+  std::size_t i = 0;
+  for (; i + LANES <= levels; i += LANES) {
+    sum += block_dot(prices + i, amounts + i);
+  }
+  for (; i < levels; ++i) {
+    sum += common_types::notional(prices[i], amounts[i]);
+  }
+  return sum;
+}
+} // namespace
+
+std::size_t levels_within(const raw_data::BookSide &side,
+                          common_types::Price limit,
+                          common_types::Side taker) noexcept {
+  const bool buy = taker == common_types::Side::Buy;
+  const Price *prices = side.prices();
+  const std::size_t levels = side.size();
+  std::size_t i = 0;
+  for (; i + LANES <= levels; i += LANES) {
+    const unsigned mask = beyond_mask(prices + i, limit, buy);
+    if (mask != 0) {
+      return i + static_cast<std::size_t>(std::countr_zero(mask));
+    }
+  }
+  for (; i < levels; ++i) {
+    if (beyond(prices[i], limit, buy)) {
+      return i;
+    }
+  }
+  return levels;
+}
+
+common_types::Amount cumulative_depth(const raw_data::BookSide &side,
+                                      std::size_t levels) noexcept {
+  const Amount *amounts = side.amounts();
+  Amount total = 0;
+  std::size_t i = 0;
+  for (; i + LANES <= levels; i += LANES) {
+    total += block_sum(amounts + i);
+  }
+  for (; i < levels; ++i) {
+    total += amounts[i];
+  }
+  return total;
+}
+
+std::size_t exhaust_level(const raw_data::BookSide &side, std::size_t levels,
+                          common_types::Amount amount) noexcept {
+  const Amount *amounts = side.amounts();
+  Amount running = 0;
+  std::size_t i = 0;
+  for (; i + LANES <= levels; i += LANES) {
+    const unsigned mask = reach_mask(amounts + i, running, amount);
+    if (mask != 0) {
+      return i + static_cast<std::size_t>(std::countr_zero(mask));
+    }
+  }
+  for (; i < levels; ++i) {
+    running += amounts[i];
+    if (running >= amount) {
+      return i;
+    }
+  }
+  return levels;
+}
+
+double vwap(const raw_data::BookSide &side, common_types::Amount amount,
+            common_types::Amount &filled) noexcept {
+  filled = 0;
+  if (amount <= 0) {
+    return 0.0;
+  }
+
+  const std::size_t levels = side.size();
+  const std::size_t last = exhaust_level(side, levels, amount);
+  Notional cash = dot(side, last);
+  if (last == levels) {
+    filled = cumulative_depth(side, levels);
+  } else {
+    const Amount rest = amount - cumulative_depth(side, last);
+    cash += common_types::notional(side.prices()[last], rest);
+    filled = amount;
+  }
+  if (filled <= 0) {
+    return 0.0;
+  }
+  return static_cast<double>(cash) / static_cast<double>(filled);
+}
+
+} // namespace execution::kernels
@@ -0,0 +1,87 @@
+#include "data_loader/event_stream.hpp"
+#include <algorithm>
+
+namespace data_loading {
+bool SnapshotEventSource::next(MarketEvent &event) {
+  const raw_data::LOBData *snapshot = source_.next();
+  if (snapshot == nullptr) {
+    return false;
+  }
+  event.type = EventType::Snapshot;
+  event.local_timestamp = snapshot->local_timestamp;
+  event.snapshot = snapshot;
+  event.trade = nullptr;
+  return true;
+}
+
+bool TradeEventSource::next(MarketEvent &event) {
+  const raw_data::TradeData *trade = source_.next();
+  if (trade == nullptr) {
+    return false;
+  }
+  event.type = EventType::Trade;
+  event.local_timestamp = trade->local_timestamp;
+  event.snapshot = nullptr;
+  event.trade = trade;
+  return true;
+}
+
+void EventStream::add_source(EventSourceAbstract::UPtr &&source) {
+  stale_.push_back(sources_.size());
+  sources_.push_back(std::move(source));
+}
+
+const MarketEvent *EventStream::next() {
+  if (has_current_) {
+    // The source of the previous event is advanced only now, so the event
+    // it returned stayed valid until this call.
+    stale_.push_back(current_.source);
+    has_current_ = false;
+  }
+  for (const std::size_t source : stale_) {
+    pull(source);
+  }
+  stale_.clear();
+
+  if (heap_.empty()) {
+    return nullptr;
+  }
+  std::pop_heap(heap_.begin(), heap_.end(), later);
+  current_ = heap_.back();
+  heap_.pop_back();
+  has_current_ = true;
+  return &current_.event;
+}
+
+bool EventStream::seek(long long timestamp) {
+  bool all_moved = true;
+  for (std::size_t i = 0; i < sources_.size(); ++i) {
+    if (!sources_[i]->seek(timestamp)) {
+      all_moved = false;
+      continue;
+    }
+    // Events read before the seek are dropped and the source is read again.
+    heap_.erase(std::remove_if(
+                    heap_.begin(), heap_.end(),
+                    [i](const Head &head) { return head.source == i; }),
+                heap_.end());
+    if (has_current_ && current_.source == i) {
+      has_current_ = false;
+    }
+    if (std::find(stale_.begin(), stale_.end(), i) == stale_.end()) {
+      stale_.push_back(i);
+    }
+  }
+  std::make_heap(heap_.begin(), heap_.end(), later);
+  return all_moved;
+}
+
+void EventStream::pull(std::size_t source) {
+  Head head;
+  head.source = source;
+  if (sources_[source]->next(head.event)) {
+    heap_.push_back(head);
+    std::push_heap(heap_.begin(), heap_.end(), later);
+  }
+}
+} // namespace data_loading
@@ -0,0 +1,152 @@
+#include "data_loader/l2_book.hpp"
+#include "data_loader/line_parsers.hpp"
+#include "logging.hpp"
+#include <algorithm>
+#include <functional>
+#include <string_view>
+
+namespace {
+/// Sets the amount at `price` in a side sorted by `Compare`, best level last.
+template <typename Compare>
+void update_level(std::vector<raw_data::OrderBookEntry> &side,
+                  const raw_data::L2Update &update, Compare compare) {
+  auto it = std::lower_bound(side.begin(), side.end(), update.price,
+                             [&](const raw_data::OrderBookEntry &entry,
+                                 common_types::Price price) {
+                               return compare(entry.price, price);
+                             });
+  const bool found = it != side.end() && it->price == update.price;
+
+  if (update.amount <= 0) {
+    if (found) {
+      side.erase(it);
+    }
+    return;
+  }
+  if (found) {
+    it->amount = update.amount;
+  } else {
+    side.insert(it, {update.price, update.amount});
+  }
+}
+
+/// Copies up to `depth` levels from the back of `side`.
+void copy_top(const std::vector<raw_data::OrderBookEntry> &side,
+              std::size_t depth, raw_data::BookSide &out) {
+  out.clear();
+  const std::size_t levels =
+      std::min({depth, side.size(), raw_data::BookSide::capacity()});
+  for (std::size_t i = 0; i < levels; ++i) {
+    out.push_back(side[side.size() - 1 - i]);
+  }
+}
+} // namespace
+
+namespace data_loading {
+std::vector<raw_data::L2Update>
+load_l2_updates(const std::string &filename,
+                const common_types::InstrumentScale &scale) {
+  std::vector<raw_data::L2Update> updates;
+  LineReader reader(filename);
+
+  std::string_view line;
+  reader.next_line(line);
+
+  raw_data::L2Update update{};
+  while (reader.next_line(line)) {
+    if (line_parsers::parse_l2_update_line(line, scale, update)) {
+      updates.push_back(update);
+    } else {
+      logging::Logger::debug("Skipping bad L2 update line: ", line);
+    }
+  }
+
+  logging::Logger::debug("Total L2 updates loaded: ", updates.size());
+  return updates;
+}
+
+void L2BookBuilder::apply(const raw_data::L2Update &update) {
+  switch (update.side) {
+  case common_types::Side::Buy:
+    update_level(bids_, update, std::less<common_types::Price>());
+    break;
+  case common_types::Side::Sell:
+    update_level(asks_, update, std::greater<common_types::Price>());
+    break;
+  default:
+    break;
+  }
+}
+
+void L2BookBuilder::clear() noexcept {
+  asks_.clear();
+  bids_.clear();
+}
+
+void L2BookBuilder::snapshot(std::size_t depth, raw_data::LOBData &out) const {
+  copy_top(asks_, depth, out.asks);
+  copy_top(bids_, depth, out.bids);
+}
+
+L2DataSource::L2DataSource(const std::string &filename,
+                           const int lob_depth_level, long long cadence,
+                           const common_types::InstrumentScale &scale)
+    : reader_(std::make_unique<LineReader>(filename)), scale_(scale),
+      depth_(static_cast<std::size_t>(std::max(lob_depth_level, 0))),
+      cadence_(cadence) {
+  std::string_view header;
+  reader_->next_line(header);
+}
+
+L2DataSource::L2DataSource(
+    std::shared_ptr<const std::vector<raw_data::L2Update>> updates,
+    const int lob_depth_level, long long cadence)
+    : updates_(std::move(updates)),
+      depth_(static_cast<std::size_t>(std::max(lob_depth_level, 0))),
+      cadence_(cadence) {}
+
+const raw_data::LOBData *L2DataSource::next() {
+  while (true) {
+    if (!has_pending_) {
+      has_pending_ = read_update(pending_);
+    }
+    if (!has_pending_) {
+      return cadence_.dirty() && publishable() ? publish() : nullptr;
+    }
+    if (cadence_.publish_before(pending_.local_timestamp) && publishable()) {
+      return publish();
+    }
+
+    book_.apply(pending_);
+    cadence_.on_update(pending_.local_timestamp);
+    has_pending_ = false;
+  }
+}
+
+bool L2DataSource::read_update(raw_data::L2Update &update) {
+  if (reader_ == nullptr) {
+    if (updates_ == nullptr || cursor_ >= updates_->size()) {
+      return false;
+    }
+    update = (*updates_)[cursor_++];
+    return true;
+  }
+
+  std::string_view line;
+  while (reader_->next_line(line)) {
+    if (line_parsers::parse_l2_update_line(line, scale_, update)) {
+      return true;
+    }
+    logging::Logger::debug("Skipping bad L2 update line: ", line);
+  }
+  return false;
+}
+
+const raw_data::LOBData *L2DataSource::publish() {
+  current_.local_timestamp = cadence_.book_timestamp();
+  book_.snapshot(depth_, current_);
+  cadence_.on_publish();
+  published_ = true;
+  return &current_;
+}
+} // namespace data_loading
@@ -0,0 +1,290 @@
+#include "data_loader/l3_book.hpp"
+#include "data_loader/line_parsers.hpp"
+#include "logging.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <string_view>
+
+namespace data_loading {
+std::vector<raw_data::L3Event>
+load_l3_events(const std::string &filename,
+               const common_types::InstrumentScale &scale) {
+  std::vector<raw_data::L3Event> events;
+  LineReader reader(filename);
+
+  std::string_view line;
+  reader.next_line(line);
+
+  raw_data::L3Event event{};
+  while (reader.next_line(line)) {
+    if (line_parsers::parse_l3_event_line(line, scale, event)) {
+      events.push_back(event);
+    } else {
+      logging::Logger::debug("Skipping bad L3 event line: ", line);
+    }
+  }
+
+  logging::Logger::debug("Total L3 events loaded: ", events.size());
+  return events;
+}
+
+L3OrderBook::L3OrderBook(std::size_t expected_orders)
+    : ids_(expected_orders) {
+  nodes_.reserve(expected_orders);
+}
+
+bool L3OrderBook::apply(const raw_data::L3Event &event) {
+  switch (event.action) {
+  case raw_data::L3Action::Add:
+    return add(event.order_id, event.side, event.price, event.amount);
+  case raw_data::L3Action::Modify:
+    return modify(event.order_id, event.price, event.amount);
+  case raw_data::L3Action::Cancel:
+    return cancel(event.order_id);
+  case raw_data::L3Action::Execute:
+    return execute(event.order_id, event.amount);
+  }
+  return false;
+}
+
+bool L3OrderBook::add(std::uint64_t order_id, common_types::Side side,
+                      common_types::Price price, common_types::Amount amount) {
+  if (side == common_types::Side::Undefined || amount <= 0 ||
+      order_id == utils::IdMap<std::uint32_t>::EMPTY_KEY ||
+      ids_.find(order_id) != nullptr) {
+    return false;
+  }
+
+  const std::uint32_t node = allocate();
+  nodes_[node] = {order_id, price, amount, NIL, NIL, side};
+  ids_.insert(order_id, node);
+  link(node);
+  return true;
+}
+
+bool L3OrderBook::modify(std::uint64_t order_id, common_types::Price price,
+                         common_types::Amount amount) {
+  const std::uint32_t *found = ids_.find(order_id);
+  if (found == nullptr) {
+    return false;
+  }
+  if (amount <= 0) {
+    return cancel(order_id);
+  }
+
+  const std::uint32_t node = *found;
+  OrderNode &order = nodes_[node];
+  if (price == order.price && amount <= order.amount) {
+    locate(order.side, order.price)->total -= order.amount - amount;
+    order.amount = amount;
+    return true;
+  }
+
+  unlink(node);
+  order.price = price;
+  order.amount = amount;
+  link(node);
+  return true;
+}
+
+bool L3OrderBook::cancel(std::uint64_t order_id) {
+  const std::uint32_t *found = ids_.find(order_id);
+  if (found == nullptr) {
+    return false;
+  }
+  const std::uint32_t node = *found;
+  unlink(node);
+  ids_.erase(order_id);
+  release(node);
+  return true;
+}
+
+bool L3OrderBook::execute(std::uint64_t order_id,
+                          common_types::Amount amount) {
+  const std::uint32_t *found = ids_.find(order_id);
+  if (found == nullptr) {
+    return false;
+  }
+  OrderNode &order = nodes_[*found];
+  if (amount >= order.amount) {
+    return cancel(order_id);
+  }
+  locate(order.side, order.price)->total -= amount;
+  order.amount -= amount;
+  return true;
+}
+
+void L3OrderBook::clear() noexcept {
+  nodes_.clear();
+  free_head_ = NIL;
+  asks_.clear();
+  bids_.clear();
+  ids_.clear();
+}
+
+void L3OrderBook::snapshot(std::size_t depth, raw_data::LOBData &out) const {
+  const auto copy_top = [depth](const Levels &side, raw_data::BookSide &dst) {
+    dst.clear();
+    const std::size_t levels =
+        std::min({depth, side.size(), raw_data::BookSide::capacity()});
+    for (std::size_t i = 0; i < levels; ++i) {
+      const Level &level = side[side.size() - 1 - i];
+      dst.push_back({level.price, level.total});
+    }
+  };
+  copy_top(asks_, out.asks);
+  copy_top(bids_, out.bids);
+}
+
+bool L3OrderBook::queue_ahead(std::uint64_t order_id,
+                              common_types::Amount &ahead) const {
+  const std::uint32_t *found = ids_.find(order_id);
+  if (found == nullptr) {
+    return false;
+  }
+  ahead = 0;
+  for (std::uint32_t node = nodes_[*found].prev; node != NIL;
+       node = nodes_[node].prev) {
+    ahead += nodes_[node].amount;
+  }
+  return true;
+}
+
+std::uint32_t L3OrderBook::allocate() {
+  if (free_head_ != NIL) {
+    const std::uint32_t node = free_head_;
+    free_head_ = nodes_[node].next;
+    return node;
+  }
+  if (nodes_.size() >= NIL) {
+    throw std::length_error("L3OrderBook: too many resting orders");
+  }
+  nodes_.emplace_back();
+  return static_cast<std::uint32_t>(nodes_.size() - 1);
+}
+
+void L3OrderBook::release(std::uint32_t node) noexcept {
+  nodes_[node].next = free_head_;
+  free_head_ = node;
+}
+
+L3OrderBook::Levels::iterator L3OrderBook::locate(common_types::Side side,
+                                                  common_types::Price price) {
+  Levels &book_side = levels(side);
+  if (side == common_types::Side::Buy) {
+    return std::lower_bound(book_side.begin(), book_side.end(), price,
+                            [](const Level &level, common_types::Price p) {
+                              return level.price < p;
+                            });
+  }
+  return std::lower_bound(book_side.begin(), book_side.end(), price,
+                          [](const Level &level, common_types::Price p) {
+                            return level.price > p;
+                          });
+}
+
+void L3OrderBook::link(std::uint32_t node) {
+  OrderNode &order = nodes_[node];
+  Levels &book_side = levels(order.side);
+  auto it = locate(order.side, order.price);
+  if (it == book_side.end() || it->price != order.price) {
+    it = book_side.insert(it, {order.price, 0, NIL, NIL});
+  }
+
+  order.prev = it->tail;
+  order.next = NIL;
+  if (it->tail != NIL) {
+    nodes_[it->tail].next = node;
+  } else {
+    it->head = node;
+  }
+  it->tail = node;
+  it->total += order.amount;
+}
+
+void L3OrderBook::unlink(std::uint32_t node) {
+  OrderNode &order = nodes_[node];
+  auto it = locate(order.side, order.price);
+
+  if (order.prev != NIL) {
+    nodes_[order.prev].next = order.next;
+  } else {
+    it->head = order.next;
+  }
+  if (order.next != NIL) {
+    nodes_[order.next].prev = order.prev;
+  } else {
+    it->tail = order.prev;
+  }
+  it->total -= order.amount;
+
+  if (it->head == NIL) {
+    levels(order.side).erase(it);
+  }
+}
+
+L3DataSource::L3DataSource(const std::string &filename,
+                           const int lob_depth_level, long long cadence,
+                           const common_types::InstrumentScale &scale)
+    : reader_(std::make_unique<LineReader>(filename)), scale_(scale),
+      depth_(static_cast<std::size_t>(std::max(lob_depth_level, 0))),
+      cadence_(cadence) {
+  std::string_view header;
+  reader_->next_line(header);
+}
+
+L3DataSource::L3DataSource(
+    std::shared_ptr<const std::vector<raw_data::L3Event>> events,
+    const int lob_depth_level, long long cadence)
+    : events_(std::move(events)),
+      depth_(static_cast<std::size_t>(std::max(lob_depth_level, 0))),
+      cadence_(cadence) {}
+
+const raw_data::LOBData *L3DataSource::next() {
+  while (true) {
+    if (!has_pending_) {
+      has_pending_ = read_event(pending_);
+    }
+    if (!has_pending_) {
+      return cadence_.dirty() && publishable() ? publish() : nullptr;
+    }
+    if (cadence_.publish_before(pending_.local_timestamp) && publishable()) {
+      return publish();
+    }
+
+    if (!book_.apply(pending_)) {
+      logging::Logger::debug("Skipping inconsistent L3 event for order ",
+                             pending_.order_id);
+    }
+    cadence_.on_update(pending_.local_timestamp);
+    has_pending_ = false;
+  }
+}
+
+bool L3DataSource::read_event(raw_data::L3Event &event) {
+  if (reader_ == nullptr) {
+    if (events_ == nullptr || cursor_ >= events_->size()) {
+      return false;
+    }
+    event = (*events_)[cursor_++];
+    return true;
+  }
+
+  std::string_view line;
+  while (reader_->next_line(line)) {
+    if (line_parsers::parse_l3_event_line(line, scale_, event)) {
+      return true;
+    }
+    logging::Logger::debug("Skipping bad L3 event line: ", line);
+  }
+  return false;
+}
+
+const raw_data::LOBData *L3DataSource::publish() {
+  current_.local_timestamp = cadence_.book_timestamp();
+  book_.snapshot(depth_, current_);
+  cadence_.on_publish();
+  published_ = true;
+  return &current_;
+}
+} // namespace data_loading
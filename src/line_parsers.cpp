@@ -0,0 +1,258 @@
+#include "data_loader/line_parsers.hpp"
+#include "types.hpp"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstddef>
+
+namespace {
+/// Extracts the next comma separated cell, mirroring std::getline(ss, ',').
+inline bool next_cell(std::string_view line, std::size_t &pos,
+                      std::string_view &cell) {
+  if (pos >= line.size()) {
+    return false;
+  }
+  const std::size_t comma = line.find(',', pos);
+  const std::size_t end =
+      (comma == std::string_view::npos) ? line.size() : comma;
+  cell = line.substr(pos, end - pos);
+  pos = (comma == std::string_view::npos) ? line.size() : comma + 1;
+  return true;
+}
+
+/// Skips leading whitespace and an explicit '+' like std::stod/std::stoll.
+inline const char *skip_prefix(const char *first, const char *last) {
+  while (first != last && std::isspace(static_cast<unsigned char>(*first))) {
+    ++first;
+  }
+  if (first != last && *first == '+') {
+    ++first;
+  }
+  return first;
+}
+
+template <typename T> inline bool parse_number(std::string_view cell, T &out) {
+  const char *first = skip_prefix(cell.data(), cell.data() + cell.size());
+  const auto res = std::from_chars(first, cell.data() + cell.size(), out);
+  return res.ec == std::errc{};
+}
+
+inline bool iequals(std::string_view lhs, std::string_view rhs) {
+  if (lhs.size() != rhs.size()) {
+    return false;
+  }
+  for (std::size_t i = 0; i < lhs.size(); ++i) {
+    if (std::tolower(static_cast<unsigned char>(lhs[i])) != rhs[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+inline common_types::Side parse_side(std::string_view cell) {
+  if (iequals(cell, "sell")) {
+    return common_types::Side::Sell;
+  }
+  if (iequals(cell, "buy")) {
+    return common_types::Side::Buy;
+  }
+  return common_types::Side::Undefined;
+}
+
+/// Book side of an L2 update: bids are Buy, asks are Sell.
+inline common_types::Side parse_book_side(std::string_view cell) {
+  if (iequals(cell, "bid") || iequals(cell, "buy")) {
+    return common_types::Side::Buy;
+  }
+  if (iequals(cell, "ask") || iequals(cell, "sell")) {
+    return common_types::Side::Sell;
+  }
+  return common_types::Side::Undefined;
+}
+
+/// Action of an L3 event; false if unknown.
+inline bool parse_l3_action(std::string_view cell, raw_data::L3Action &action) {
+  if (iequals(cell, "add")) {
+    action = raw_data::L3Action::Add;
+  } else if (iequals(cell, "modify")) {
+    action = raw_data::L3Action::Modify;
+  } else if (iequals(cell, "cancel")) {
+    action = raw_data::L3Action::Cancel;
+  } else if (iequals(cell, "execute")) {
+    action = raw_data::L3Action::Execute;
+  } else {
+    return false;
+  }
+  return true;
+}
+} // namespace
+
+namespace data_loading::line_parsers {
+bool parse_timestamp(std::string_view line, long long &timestamp) {
+  std::size_t pos = 0;
+  std::string_view cell;
+
+  next_cell(line, pos, cell);
+  return next_cell(line, pos, cell) && parse_number(cell, timestamp);
+}
+
+bool parse_lob_line(std::string_view line, int lob_depth_level,
+                    const common_types::InstrumentScale &scale,
+                    raw_data::LOBData &entry) {
+  entry.asks.clear();
+  entry.bids.clear();
+
+  std::size_t pos = 0;
+  std::string_view cell;
+
+  next_cell(line, pos, cell);
+  if (!next_cell(line, pos, cell) ||
+      !parse_number(cell, entry.local_timestamp)) {
+    return false;
+  }
+
+  const int depth =
+      std::min(lob_depth_level, static_cast<int>(raw_data::MAX_LOB_DEPTH));
+  for (int i = 0; i < depth; ++i) {
+    double ask_price = 0.0, ask_amount = 0.0, bid_price = 0.0,
+           bid_amount = 0.0;
+
+    std::string_view ask_price_cell, ask_amount_cell, bid_price_cell,
+        bid_amount_cell;
+    if (!next_cell(line, pos, ask_price_cell) ||
+        !next_cell(line, pos, ask_amount_cell) ||
+        !next_cell(line, pos, bid_price_cell) ||
+        !next_cell(line, pos, bid_amount_cell)) {
+      break;
+    }
+
+    if (!parse_number(ask_price_cell, ask_price) ||
+        !parse_number(ask_amount_cell, ask_amount) ||
+        !parse_number(bid_price_cell, bid_price) ||
+        !parse_number(bid_amount_cell, bid_amount)) {
+      continue;
+    }
+
+    const raw_data::OrderBookEntry ask{scale.to_price(ask_price),
+                                       scale.to_amount(ask_amount)};
+    const raw_data::OrderBookEntry bid{scale.to_price(bid_price),
+                                       scale.to_amount(bid_amount)};
+    if (ask.price > 0 && ask.amount > 0) {
+      entry.asks.push_back(ask);
+    }
+    if (bid.price > 0 && bid.amount > 0) {
+      entry.bids.push_back(bid);
+    }
+  }
+
+  return true;
+}
+
+bool parse_trade_line(std::string_view line,
+                      const common_types::InstrumentScale &scale,
+                      raw_data::TradeData &trade) {
+  std::size_t pos = 0;
+  std::string_view cell;
+
+  next_cell(line, pos, cell);
+  if (!next_cell(line, pos, cell) ||
+      !parse_number(cell, trade.local_timestamp)) {
+    return false;
+  }
+
+  trade.side = next_cell(line, pos, cell) ? parse_side(cell)
+                                          : common_types::Side::Undefined;
+
+  double price = 0.0, amount = 0.0;
+  if (!next_cell(line, pos, cell) || !parse_number(cell, price)) {
+    return false;
+  }
+
+  if (!next_cell(line, pos, cell) || !parse_number(cell, amount)) {
+    return false;
+  }
+
+  trade.price = scale.to_price(price);
+  trade.amount = scale.to_amount(amount);
+  return true;
+}
+
+bool parse_l2_update_line(std::string_view line,
+                          const common_types::InstrumentScale &scale,
+                          raw_data::L2Update &update) {
+  std::size_t pos = 0;
+  std::string_view cell;
+
+  next_cell(line, pos, cell);
+  if (!next_cell(line, pos, cell) ||
+      !parse_number(cell, update.local_timestamp)) {
+    return false;
+  }
+
+  if (!next_cell(line, pos, cell)) {
+    return false;
+  }
+  update.side = parse_book_side(cell);
+  if (update.side == common_types::Side::Undefined) {
+    return false;
+  }
+
+  double price = 0.0, amount = 0.0;
+  if (!next_cell(line, pos, cell) || !parse_number(cell, price)) {
+    return false;
+  }
+
+  if (!next_cell(line, pos, cell) || !parse_number(cell, amount)) {
+    return false;
+  }
+
+  update.price = scale.to_price(price);
+  update.amount = scale.to_amount(amount);
+  return true;
+}
+
+bool parse_l3_event_line(std::string_view line,
+                         const common_types::InstrumentScale &scale,
+                         raw_data::L3Event &event) {
+  std::size_t pos = 0;
+  std::string_view cell;
+
+  next_cell(line, pos, cell);
+  if (!next_cell(line, pos, cell) ||
+      !parse_number(cell, event.local_timestamp)) {
+    return false;
+  }
+
+  if (!next_cell(line, pos, cell) || !parse_number(cell, event.order_id)) {
+    return false;
+  }
+
+  if (!next_cell(line, pos, cell) || !parse_l3_action(cell, event.action)) {
+    return false;
+  }
+
+  event.side = next_cell(line, pos, cell) ? parse_book_side(cell)
+                                          : common_types::Side::Undefined;
+
+  double price = 0.0, amount = 0.0;
+  const bool has_price = next_cell(line, pos, cell) && !cell.empty();
+  if (has_price && !parse_number(cell, price)) {
+    return false;
+  }
+  const bool has_amount = next_cell(line, pos, cell) && !cell.empty();
+  if (has_amount && !parse_number(cell, amount)) {
+    return false;
+  }
+  if (event.action != raw_data::L3Action::Cancel &&
+      (!has_amount ||
+       (event.action != raw_data::L3Action::Execute && !has_price) ||
+       (event.action == raw_data::L3Action::Add &&
+        event.side == common_types::Side::Undefined))) {
+    return false;
+  }
+
+  event.price = scale.to_price(price);
+  event.amount = scale.to_amount(amount);
+  return true;
+}
+} // namespace data_loading::line_parsers
@@ -0,0 +1,61 @@
+#include "data_loader/line_reader.hpp"
+#include <cstring>
+
+namespace data_loading {
+LineReader::LineReader(const std::string &filename, std::size_t buffer_size)
+    : source_(open_byte_source(filename)),
+      buffer_(buffer_size > 0 ? buffer_size : 1) {}
+
+bool LineReader::next_line(std::string_view &line) {
+  while (true) {
+    const char *begin = buffer_.data() + pos_;
+    const auto *eol =
+        static_cast<const char *>(std::memchr(begin, '\n', end_ - pos_));
+    if (eol != nullptr) {
+      line = std::string_view(begin, eol - begin);
+      pos_ += line.size() + 1;
+      return true;
+    }
+
+    if (eof_) {
+      if (pos_ == end_) {
+        return false;
+      }
+      line = std::string_view(begin, end_ - pos_);
+      pos_ = end_;
+      return true;
+    }
+
+    refill();
+  }
+}
+
+bool LineReader::seek(std::size_t offset) {
+  if (!source_->seek(offset)) {
+    return false;
+  }
+  pos_ = 0;
+  end_ = 0;
+  eof_ = false;
+  return true;
+}
+
+bool LineReader::refill() {
+  const std::size_t unread = end_ - pos_;
+  if (pos_ > 0) {
+    std::memmove(buffer_.data(), buffer_.data() + pos_, unread);
+  } else if (unread == buffer_.size()) {
+    buffer_.resize(buffer_.size() * 2);
+  }
+  pos_ = 0;
+  end_ = unread;
+
+  const std::size_t read =
+      source_->read(buffer_.data() + end_, buffer_.size() - end_);
+  end_ += read;
+  if (read == 0) {
+    eof_ = true;
+  }
+  return read > 0;
+}
+} // namespace data_loading
@@ -0,0 +1,201 @@
+#include "data_loader/lob_arena.hpp"
+#include "logging.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <type_traits>
+#include <utility>
+
+namespace {
+static_assert(std::is_same_v<common_types::Price, common_types::Amount>,
+              "LOBArena stores prices and amounts in one value array");
+
+/// Size and alignment of a transparent huge page.
+constexpr std::size_t HUGE_PAGE_SIZE = std::size_t{2} << 20;
+
+/// Alignment of the level values following the record table.
+constexpr std::size_t CACHE_LINE = 64;
+
+/// Rounds `bytes` up to a multiple of `alignment` (a power of two).
+constexpr std::size_t align_up(std::size_t bytes, std::size_t alignment) {
+  return (bytes + alignment - 1) & ~(alignment - 1);
+}
+
+/// Maps anonymous read-write memory, throwing on failure.
+void *map_anonymous(std::size_t bytes) {
+  void *addr = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (addr == MAP_FAILED) {
+    throw std::runtime_error("Cannot map LOB arena");
+  }
+  return addr;
+}
+
+/**
+ * @brief Maps the arena, on a huge page boundary if requested.
+ *
+ * @param bytes Requested size; rounded up to whole huge pages when they are
+ * used.
+ * @param huge_pages Advise the kernel to use transparent huge pages.
+ * @param advised Output, true if the advice was accepted.
+ */
+void *map_arena(std::size_t &bytes, bool huge_pages, bool &advised) {
+  advised = false;
+  if (!huge_pages || bytes < HUGE_PAGE_SIZE) {
+    return map_anonymous(bytes);
+  }
+
+  // Over-map by one huge page and trim, so the arena starts on a huge page
+  // boundary and every page of it can be promoted.
+  bytes = align_up(bytes, HUGE_PAGE_SIZE);
+  const std::size_t mapped = bytes + HUGE_PAGE_SIZE;
+  char *raw = static_cast<char *>(map_anonymous(mapped));
+  const auto start = reinterpret_cast<std::uintptr_t>(raw);
+  const std::size_t head = align_up(start, HUGE_PAGE_SIZE) - start;
+  const std::size_t tail = mapped - head - bytes;
+  if (head != 0) {
+    ::munmap(raw, head);
+  }
+  if (tail != 0) {
+    ::munmap(raw + head + bytes, tail);
+  }
+#ifdef MADV_HUGEPAGE
+  advised = ::madvise(raw + head, bytes, MADV_HUGEPAGE) == 0;
+#endif
+  return raw + head;
+}
+} // namespace
+
+namespace data_loading {
+void LOBView::copy_to(raw_data::LOBData &out) const {
+  out.local_timestamp = local_timestamp;
+  out.asks.assign(ask_prices, ask_amounts, ask_count);
+  out.bids.assign(bid_prices, bid_amounts, bid_count);
+}
+
+LOBArena LOBArena::build(const std::vector<raw_data::LOBData> &lob_data,
+                         bool huge_pages) {
+  LOBArena arena;
+  if (lob_data.empty()) {
+    return arena;
+  }
+
+  std::size_t values = 0;
+  for (const auto &snapshot : lob_data) {
+    values += 2 * (snapshot.asks.size() + snapshot.bids.size());
+  }
+  const std::size_t record_bytes =
+      align_up(lob_data.size() * sizeof(Record), CACHE_LINE);
+  std::size_t bytes = record_bytes + values * sizeof(common_types::Price);
+
+  arena.base_ = map_arena(bytes, huge_pages, arena.huge_pages_);
+  arena.bytes_ = bytes;
+  arena.size_ = lob_data.size();
+
+  char *base = static_cast<char *>(arena.base_);
+  auto *records = reinterpret_cast<Record *>(base);
+  auto *out = reinterpret_cast<common_types::Price *>(base + record_bytes);
+  std::uint64_t offset = 0;
+  for (std::size_t i = 0; i < lob_data.size(); ++i) {
+    const auto &snapshot = lob_data[i];
+    const std::size_t asks = snapshot.asks.size();
+    const std::size_t bids = snapshot.bids.size();
+    records[i] = {snapshot.local_timestamp, offset,
+                  static_cast<std::uint32_t>(asks),
+                  static_cast<std::uint32_t>(bids)};
+    out = std::copy_n(snapshot.asks.prices(), asks, out);
+    out = std::copy_n(snapshot.asks.amounts(), asks, out);
+    out = std::copy_n(snapshot.bids.prices(), bids, out);
+    out = std::copy_n(snapshot.bids.amounts(), bids, out);
+    offset += 2 * (asks + bids);
+  }
+
+  // The arena is immutable from now on.
+  ::mprotect(arena.base_, arena.bytes_, PROT_READ);
+  arena.records_ = records;
+  arena.values_ = reinterpret_cast<const common_types::Price *>(
+      base + record_bytes);
+
+  logging::Logger::debug("LOB arena: ", arena.size_, " snapshots in ",
+                         arena.bytes_, " bytes, huge pages: ",
+                         arena.huge_pages_);
+  return arena;
+}
+
+LOBArena::~LOBArena() { release(); }
+
+LOBArena::LOBArena(LOBArena &&other) noexcept
+    : base_(std::exchange(other.base_, nullptr)),
+      bytes_(std::exchange(other.bytes_, 0)),
+      size_(std::exchange(other.size_, 0)),
+      records_(std::exchange(other.records_, nullptr)),
+      values_(std::exchange(other.values_, nullptr)),
+      huge_pages_(std::exchange(other.huge_pages_, false)) {}
+
+LOBArena &LOBArena::operator=(LOBArena &&other) noexcept {
+  if (this != &other) {
+    release();
+    base_ = std::exchange(other.base_, nullptr);
+    bytes_ = std::exchange(other.bytes_, 0);
+    size_ = std::exchange(other.size_, 0);
+    records_ = std::exchange(other.records_, nullptr);
+    values_ = std::exchange(other.values_, nullptr);
+    huge_pages_ = std::exchange(other.huge_pages_, false);
+  }
+  return *this;
+}
+
+LOBView LOBArena::view(std::size_t i) const noexcept {
+  const Record &record = records_[i];
+  const common_types::Price *asks = values_ + record.offset;
+  const common_types::Price *bids = asks + 2 * record.ask_count;
+  return {record.local_timestamp,
+          asks,
+          asks + record.ask_count,
+          record.ask_count,
+          bids,
+          bids + record.bid_count,
+          record.bid_count};
+}
+
+std::size_t LOBArena::lower_bound(long long timestamp) const noexcept {
+  const Record *end = records_ + size_;
+  const Record *it =
+      std::lower_bound(records_, end, timestamp,
+                       [](const Record &record, long long ts) {
+                         return record.local_timestamp < ts;
+                       });
+  return static_cast<std::size_t>(it - records_);
+}
+
+void LOBArena::release() noexcept {
+  if (base_ != nullptr) {
+    ::munmap(base_, bytes_);
+    base_ = nullptr;
+    bytes_ = 0;
+    size_ = 0;
+    records_ = nullptr;
+    values_ = nullptr;
+  }
+}
+
+ArenaDataSource::ArenaDataSource(std::shared_ptr<const LOBArena> arena)
+    : arena_(std::move(arena)) {}
+
+const raw_data::LOBData *ArenaDataSource::next() {
+  if (arena_ == nullptr || cursor_ >= arena_->size()) {
+    return nullptr;
+  }
+  arena_->load(cursor_++, current_);
+  return &current_;
+}
+
+bool ArenaDataSource::seek(long long timestamp) {
+  if (arena_ == nullptr) {
+    return false;
+  }
+  cursor_ = arena_->lower_bound(timestamp);
+  return true;
+}
+} // namespace data_loading
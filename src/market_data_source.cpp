@@ -0,0 +1,70 @@
+#include "data_loader/market_data_source.hpp"
+#include <algorithm>
+
+namespace data_loading {
+InMemoryDataSource::InMemoryDataSource(std::vector<raw_data::LOBData> lob_data)
+    : data_(std::make_shared<const std::vector<raw_data::LOBData>>(
+          std::move(lob_data))) {}
+
+InMemoryDataSource::InMemoryDataSource(
+    std::shared_ptr<const std::vector<raw_data::LOBData>> lob_data)
+    : data_(std::move(lob_data)) {}
+
+const raw_data::LOBData *InMemoryDataSource::next() {
+  if (data_ == nullptr || cursor_ >= data_->size()) {
+    return nullptr;
+  }
+  return &(*data_)[cursor_++];
+}
+
+bool InMemoryDataSource::seek(long long timestamp) {
+  if (data_ == nullptr) {
+    return false;
+  }
+  const auto it = std::lower_bound(
+      data_->begin(), data_->end(), timestamp,
+      [](const raw_data::LOBData &snapshot, long long ts) {
+        return snapshot.local_timestamp < ts;
+      });
+  cursor_ = static_cast<std::size_t>(it - data_->begin());
+  return true;
+}
+
+CSVDataSource::CSVDataSource(const std::string &filename,
+                             const int lob_depth_level,
+                             std::size_t buffer_size,
+                             const common_types::InstrumentScale &scale)
+    : cursor_(filename, buffer_size), lob_depth_level_(lob_depth_level),
+      scale_(scale) {}
+
+const raw_data::LOBData *CSVDataSource::next() {
+  return cursor_.next(current_, parser()) ? &current_ : nullptr;
+}
+
+bool CSVDataSource::seek(long long timestamp) {
+  return cursor_.seek(timestamp, current_, parser());
+}
+
+BinaryDataSource::BinaryDataSource(
+    std::shared_ptr<const BinaryLOBFile> lob_file)
+    : file_(std::move(lob_file)) {}
+
+const raw_data::LOBData *BinaryDataSource::next() {
+  if (file_ == nullptr || cursor_ >= file_->size()) {
+    return nullptr;
+  }
+  file_->load(cursor_++, current_);
+  return &current_;
+}
+
+bool BinaryDataSource::seek(long long timestamp) {
+  if (file_ == nullptr) {
+    return false;
+  }
+  const std::int64_t *begin = file_->timestamps();
+  const std::int64_t *end = begin + file_->size();
+  cursor_ = static_cast<std::size_t>(std::lower_bound(begin, end, timestamp) -
+                                     begin);
+  return true;
+}
+} // namespace data_loading
@@ -6,6 +6,23 @@
 #include <stdexcept>
 #include <vector>
 
+namespace {
+/// Drops the first `amount` of `fills`, which are best price first.
+void drop_front(std::vector<common_types::ExecutionFill> &fills,
+                common_types::Amount amount) {
+  auto kept = fills.begin();
+  for (auto &fill : fills) {
+    const common_types::Amount dropped = std::min(amount, fill.amount);
+    fill.amount -= dropped;
+    amount -= dropped;
+    if (fill.amount > 0) {
+      *kept++ = fill;
+    }
+  }
+  fills.erase(kept, fills.end());
+}
+} // namespace
+
 namespace execution {
 
 MarketEngine::MarketEngine() {
@@ -26,24 +43,169 @@ void MarketEngine::add_order(const common_types::Order &order) {
       " amount=", order.amount, " price=", order.price);
 
   pending_orders_.push_back(order);
+  assign_id(pending_orders_.back());
+}
+
+void MarketEngine::add_orders(std::span<const common_types::Order> orders) {
+  for (const auto &order : orders) {
+    add_order(order);
+  }
+}
+
+void MarketEngine::add_order(const common_types::Order &order,
+                             long long timestamp) {
+  if (submit_latency_ == nullptr) {
+    add_order(order);
+    return;
+  }
+
+  InFlight message{timestamp + submit_latency_->sample(), ++last_seq_, order,
+                   false};
+  assign_id(message.order);
+  logging::Logger::debug("[ENGINE] Order id=", message.order.id,
+                         " in flight until ", message.time);
+  in_flight_.push_back(message);
+  std::push_heap(in_flight_.begin(), in_flight_.end(), later<InFlight>);
+}
+
+void MarketEngine::add_orders(std::span<const common_types::Order> orders,
+                              long long timestamp) {
+  for (const auto &order : orders) {
+    add_order(order, timestamp);
+  }
+}
+
+void MarketEngine::cancel(std::uint64_t id, long long timestamp) {
+  if (submit_latency_ == nullptr) {
+    cancel(id);
+    return;
+  }
+
+  InFlight message{timestamp + submit_latency_->sample(), ++last_seq_, {},
+                   true};
+  message.order.id = id;
+  in_flight_.push_back(message);
+  std::push_heap(in_flight_.begin(), in_flight_.end(), later<InFlight>);
+}
+
+void MarketEngine::advance_to(long long timestamp) {
+  now_ = std::max(now_, timestamp);
+  while (!acks_.empty() && acks_.front().time <= now_) {
+    std::pop_heap(acks_.begin(), acks_.end(), later<Ack>);
+    const Ack ack = std::move(acks_.back());
+    acks_.pop_back();
+    if (listener_ == nullptr) {
+      continue;
+    }
+    if (ack.fills.empty()) {
+      listener_->on_order_rejected(ack.order, ack.reason);
+    } else {
+      listener_->on_fill(ack.order, ack.fills);
+    }
+  }
+}
+
+void MarketEngine::release(long long timestamp) {
+  now_ = std::max(now_, timestamp);
+  while (!in_flight_.empty() && in_flight_.front().time <= timestamp) {
+    std::pop_heap(in_flight_.begin(), in_flight_.end(), later<InFlight>);
+    const InFlight message = in_flight_.back();
+    in_flight_.pop_back();
+    if (message.cancel) {
+      cancel(message.order.id);
+    } else {
+      logging::Logger::debug("[ENGINE] Order id=", message.order.id,
+                             " reached the book");
+      pending_orders_.push_back(message.order);
+    }
+  }
 }
 
 bool MarketEngine::tick(const raw_data::LOBData &data,
                         vault::Portfolio::SPtr &portfolio) {
-  auto new_end = std::remove_if(pending_orders_.begin(), pending_orders_.end(),
-                                [&](const common_types::Order &order) {
-                                  return execute(order, data, portfolio);
-                                });
+  return tick(BookFeatures(data), portfolio);
+}
+
+bool MarketEngine::tick(const BookFeatures &features,
+                        vault::Portfolio::SPtr &portfolio) {
+  release(features.data().local_timestamp);
+  return process(features, portfolio, 0);
+}
+
+bool MarketEngine::submit_and_tick(const common_types::Order &order,
+                                   long long timestamp,
+                                   const BookFeatures &features,
+                                   vault::Portfolio::SPtr &portfolio) {
+  const std::size_t first = pending_orders_.size();
+  add_order(order, timestamp);
+  return process(features, portfolio, first);
+}
+
+bool MarketEngine::process(const BookFeatures &features,
+                           vault::Portfolio::SPtr &portfolio,
+                           std::size_t first) {
+  bool any_executed = false;
+  auto new_end = std::remove_if(
+      pending_orders_.begin() + first, pending_orders_.end(),
+      [&](const common_types::Order &order) {
+        if (order.order_type == orders::OrderTypes::LimitGtc ||
+            order.order_type == orders::OrderTypes::PostOnly) {
+          // Leaves the pool either way: filled, resting or rejected.
+          any_executed |= place(order, features, portfolio);
+          return true;
+        }
+        const bool executed = execute(order, features, portfolio);
+        any_executed |= executed;
+        return executed;
+      });
 
-  bool any_executed = (new_end != pending_orders_.end());
   pending_orders_.erase(new_end, pending_orders_.end());
 
   return any_executed;
 }
 
+void MarketEngine::update_resting(const BookFeatures &features,
+                                  vault::Portfolio::SPtr &portfolio) {
+  if (resting_.empty()) {
+    return;
+  }
+  resting_fills_.clear();
+  resting_.on_snapshot(features, resting_fills_);
+  settle_resting(portfolio);
+}
+
+void MarketEngine::on_market_trade(const raw_data::TradeData &trade,
+                                   vault::Portfolio::SPtr &portfolio) {
+  if (resting_.empty()) {
+    return;
+  }
+  resting_fills_.clear();
+  resting_.on_trade(trade, resting_fills_);
+  settle_resting(portfolio);
+}
+
+bool MarketEngine::cancel(std::uint64_t id) {
+  const auto it =
+      std::find_if(pending_orders_.begin(), pending_orders_.end(),
+                   [id](const common_types::Order &order) {
+                     return order.id == id;
+                   });
+  if (it != pending_orders_.end()) {
+    pending_orders_.erase(it);
+    return true;
+  }
+  return resting_.cancel(id);
+}
+
 bool MarketEngine::execute(const common_types::Order &order,
                            const raw_data::LOBData &data,
                            vault::Portfolio::SPtr &portfolio) {
+  return execute(order, BookFeatures(data), portfolio);
+}
+
+bool MarketEngine::execute(const common_types::Order &order,
+                           const BookFeatures &features,
+                           vault::Portfolio::SPtr &portfolio) {
   logging::Logger::debug(
       "[ENGINE] Strategy generated order: side=", static_cast<int>(order.side),
       " amount=", order.amount, " price=", order.price);
@@ -51,44 +213,141 @@ bool MarketEngine::execute(const common_types::Order &order,
   auto order_executor_it = orders_execution_policy_.find(order.order_type);
 
   if (order_executor_it == orders_execution_policy_.end()) {
-    throw std::runtime_error("Unsupported order type: there are only Market, "
-                             "LimitFok and LimitIoc.");
+    throw std::runtime_error("Unsupported order type: only Market, LimitFok "
+                             "and LimitIoc execute immediately.");
   }
 
   const std::vector<common_types::ExecutionFill> fills =
-      order_executor_it->second->execute_order(order, data);
+      order_executor_it->second->execute_order(order, features);
 
   if (fills.empty()) {
     logging::Logger::debug("[ENGINE] No fills executed.");
-    return false;
+    return reject(order, common_types::RejectReason::NoLiquidity);
+  }
+
+  return settle(order, fills, portfolio);
+}
+
+bool MarketEngine::place(const common_types::Order &order,
+                         const BookFeatures &features,
+                         vault::Portfolio::SPtr &portfolio) {
+  if (order.side == common_types::Side::Undefined) {
+    throw std::runtime_error("Undefined order side type");
+  }
+  if (resting_.contains(order.id)) {
+    logging::Logger::debug("[ENGINE] Order id=", order.id,
+                           " is already resting.");
+    return reject(order, common_types::RejectReason::DuplicateId);
+  }
+
+  const bool crosses = features.levels_within(order.price, order.side) > 0;
+  common_types::Amount remaining = order.amount;
+  common_types::Amount taken{};
+  bool executed = false;
+
+  if (crosses) {
+    if (order.order_type == orders::OrderTypes::PostOnly) {
+      logging::Logger::debug("[ENGINE] PostOnly order would cross.");
+      return reject(order, common_types::RejectReason::WouldCross);
+    }
+    // The marketable part takes liquidity like an IOC order, after what
+    // own resting orders already took from the best levels.
+    taken = resting_.crossed(order.side, order.price, features);
+    common_types::Order marketable = order;
+    marketable.amount += taken;
+    std::vector<common_types::ExecutionFill> fills =
+        orders_execution_policy_.at(orders::OrderTypes::LimitIoc)
+            ->execute_order(marketable, features);
+    drop_front(fills, taken);
+    if (!fills.empty()) {
+      if (!settle(order, fills, portfolio)) {
+        return false;
+      }
+      for (const auto &fill : fills) {
+        remaining -= fill.amount;
+      }
+      executed = true;
+    }
+  }
+
+  if (remaining > 0) {
+    // The crossing liquidity the order took must not fill it again.
+    resting_.add(order, remaining, features,
+                 taken + order.amount - remaining);
+  }
+  return executed;
+}
+
+void MarketEngine::settle_resting(vault::Portfolio::SPtr &portfolio) {
+  for (const auto &resting_fill : resting_fills_) {
+    logging::Logger::debug("[ENGINE] Resting order id=", resting_fill.order.id,
+                           " filled amount=", resting_fill.fill.amount,
+                           " price=", resting_fill.fill.price);
+    resting_fill_.assign(1, resting_fill.fill);
+    if (!settle(resting_fill.order, resting_fill_, portfolio)) {
+      resting_.cancel(resting_fill.order.id);
+    }
   }
+}
 
+bool MarketEngine::settle(const common_types::Order &order,
+                          const std::vector<common_types::ExecutionFill> &fills,
+                          vault::Portfolio::SPtr &portfolio) {
   switch (order.side) {
   case common_types::Side::Buy:
-    if (portfolio->can_buy(fills)) {
-      logging::Logger::debug("[ENGINE] Portfolio CAN BUY. Executing...");
-      portfolio->update_after_buy(fills);
-      return true;
-    } else {
+    if (!portfolio->can_buy(fills)) {
       logging::Logger::debug("[ENGINE] Portfolio CANNOT BUY. Skipping.");
-      return false;
+      return reject(order, common_types::RejectReason::InsufficientCash);
     }
+    logging::Logger::debug("[ENGINE] Portfolio CAN BUY. Executing...");
+    portfolio->update_after_buy(fills);
+    break;
 
   case common_types::Side::Sell:
-    if (portfolio->can_sell(fills)) {
-      logging::Logger::debug("[ENGINE] Portfolio CAN SELL. Executing...");
-      portfolio->update_after_sell(fills);
-      return true;
-    } else {
+    if (!portfolio->can_sell(fills)) {
       logging::Logger::debug("[ENGINE] Portfolio CANNOT SELL. Skipping.");
-      return false;
+      return reject(order, common_types::RejectReason::InsufficientAssets);
     }
+    logging::Logger::debug("[ENGINE] Portfolio CAN SELL. Executing...");
+    portfolio->update_after_sell(fills);
+    break;
 
   default:
     throw std::runtime_error("Undefined order side type");
   }
 
+  report_fills(order, fills);
+  return true;
+}
+
+bool MarketEngine::reject(const common_types::Order &order,
+                          common_types::RejectReason reason) {
+  if (listener_ == nullptr) {
+    return false;
+  }
+  if (ack_latency_ == nullptr) {
+    listener_->on_order_rejected(order, reason);
+    return false;
+  }
+  acks_.push_back(
+      {now_ + ack_latency_->sample(), ++last_seq_, order, {}, reason});
+  std::push_heap(acks_.begin(), acks_.end(), later<Ack>);
   return false;
 }
 
+void MarketEngine::report_fills(
+    const common_types::Order &order,
+    const std::vector<common_types::ExecutionFill> &fills) {
+  if (listener_ == nullptr) {
+    return;
+  }
+  if (ack_latency_ == nullptr) {
+    listener_->on_fill(order, fills);
+    return;
+  }
+  acks_.push_back({now_ + ack_latency_->sample(), ++last_seq_, order, fills,
+                   common_types::RejectReason::NoLiquidity});
+  std::push_heap(acks_.begin(), acks_.end(), later<Ack>);
+}
+
 } // namespace execution
@@ -0,0 +1,218 @@
+#include "data_loader/mmap_csv_parser.hpp"
+#include "data_loader/byte_source.hpp"
+#include "data_loader/line_parsers.hpp"
+#include "data_loader/line_reader.hpp"
+#include "data_loader/mapped_file.hpp"
+#include "logging.hpp"
+#include "types.hpp"
+#include <algorithm>
+#include <cstring>
+#include <future>
+#include <iterator>
+#include <string_view>
+
+namespace {
+/// Strips the header line and returns the remaining body of the file.
+std::string_view skip_header(std::string_view content) {
+  const std::size_t eol = content.find('\n');
+  return (eol == std::string_view::npos) ? std::string_view{}
+                                         : content.substr(eol + 1);
+}
+
+/// Counts lines in the body to reserve the output vector once.
+std::size_t count_lines(std::string_view body) {
+  if (body.empty()) {
+    return 0;
+  }
+  const auto newlines =
+      static_cast<std::size_t>(std::count(body.begin(), body.end(), '\n'));
+  return newlines + (body.back() != '\n' ? 1 : 0);
+}
+
+/// Calls fn(line) for every line of the body without copying it.
+template <typename Fn> void for_each_line(std::string_view body, Fn &&fn) {
+  const char *cur = body.data();
+  const char *end = body.data() + body.size();
+  while (cur < end) {
+    const auto *eol =
+        static_cast<const char *>(std::memchr(cur, '\n', end - cur));
+    const char *line_end = (eol == nullptr) ? end : eol;
+    fn(std::string_view(cur, line_end - cur));
+    cur = line_end + 1;
+  }
+}
+
+/// Splits the body into at most `parts` pieces ending at line boundaries.
+std::vector<std::string_view> split_chunks(std::string_view body,
+                                           std::size_t parts) {
+  std::vector<std::string_view> chunks;
+  const std::size_t approx = body.size() / std::max<std::size_t>(parts, 1) + 1;
+
+  std::size_t begin = 0;
+  while (begin < body.size()) {
+    std::size_t end = std::min(begin + approx, body.size());
+    if (end < body.size()) {
+      const std::size_t eol = body.find('\n', end);
+      end = (eol == std::string_view::npos) ? body.size() : eol + 1;
+    }
+    chunks.push_back(body.substr(begin, end - begin));
+    begin = end;
+  }
+  return chunks;
+}
+
+std::vector<raw_data::LOBData>
+parse_lob_chunk(std::string_view chunk, int lob_depth_level,
+                const common_types::InstrumentScale &scale) {
+  std::vector<raw_data::LOBData> lob_data;
+  lob_data.reserve(count_lines(chunk));
+
+  raw_data::LOBData entry;
+  for_each_line(chunk, [&](std::string_view line) {
+    if (!data_loading::line_parsers::parse_lob_line(line, lob_depth_level,
+                                                    scale, entry)) {
+      logging::Logger::debug("Skipping LOB line with bad timestamp: ", line);
+      return;
+    }
+    lob_data.push_back(entry);
+  });
+  return lob_data;
+}
+
+std::vector<raw_data::TradeData>
+parse_trades_chunk(std::string_view chunk,
+                   const common_types::InstrumentScale &scale) {
+  std::vector<raw_data::TradeData> trades;
+  trades.reserve(count_lines(chunk));
+
+  raw_data::TradeData trade{};
+  for_each_line(chunk, [&](std::string_view line) {
+    if (!data_loading::line_parsers::parse_trade_line(line, scale, trade)) {
+      logging::Logger::debug("Skipping malformed trade line: ", line);
+      return;
+    }
+    trades.push_back(trade);
+  });
+  return trades;
+}
+
+/// Parses a compressed file line by line while it is inflated on another
+/// thread; compressed input cannot be mapped and split into chunks.
+template <typename T, typename ParseLine>
+std::vector<T> parse_stream(const std::string &filename,
+                            ParseLine parse_line) {
+  data_loading::LineReader reader(filename);
+  std::string_view line;
+  reader.next_line(line);
+
+  std::vector<T> result;
+  T item{};
+  while (reader.next_line(line)) {
+    if (!parse_line(line, item)) {
+      logging::Logger::debug("Skipping malformed line: ", line);
+      continue;
+    }
+    result.push_back(item);
+  }
+  return result;
+}
+
+/// Parses chunks on the pool (or inline without one) and joins in order.
+template <typename T, typename ParseFn>
+std::vector<T> parse_chunked(std::string_view body, utils::ThreadPool *pool,
+                             ParseFn parse_fn) {
+  if (pool == nullptr || pool->size() < 2) {
+    return parse_fn(body);
+  }
+
+  const auto chunks = split_chunks(body, pool->size() * 4);
+  std::vector<std::future<std::vector<T>>> futures;
+  futures.reserve(chunks.size());
+  for (const auto chunk : chunks) {
+    futures.push_back(pool->submit([chunk, &parse_fn]() {
+      return parse_fn(chunk);
+    }));
+  }
+
+  // Every task must be done with the chunks and parse_fn before an error
+  // unwinds them.
+  for (auto &future : futures) {
+    future.wait();
+  }
+
+  std::vector<std::vector<T>> parts;
+  parts.reserve(futures.size());
+  std::size_t total = 0;
+  for (auto &future : futures) {
+    parts.push_back(future.get());
+    total += parts.back().size();
+  }
+
+  std::vector<T> result;
+  result.reserve(total);
+  for (auto &part : parts) {
+    std::move(part.begin(), part.end(), std::back_inserter(result));
+  }
+  return result;
+}
+} // namespace
+
+namespace data_loading {
+MMapCSVParser::MMapCSVParser(const int lob_depth_level)
+    : lob_depth_level_(lob_depth_level) {}
+
+MMapCSVParser::MMapCSVParser(const int lob_depth_level,
+                             const std::size_t threads)
+    : lob_depth_level_(lob_depth_level) {
+  if (threads != 1) {
+    pool_ = std::make_unique<utils::ThreadPool>(threads);
+  }
+}
+
+std::vector<raw_data::LOBData>
+MMapCSVParser::parse_lob(const std::string &filename) {
+  if (is_gzip_file(filename)) {
+    auto lob_data = parse_stream<raw_data::LOBData>(
+        filename, [this](std::string_view line, raw_data::LOBData &entry) {
+          return line_parsers::parse_lob_line(line, lob_depth_level_, scale_,
+                                              entry);
+        });
+    logging::Logger::debug("Total LOB entries loaded: ", lob_data.size());
+    return lob_data;
+  }
+
+  const MappedFile file(filename);
+  const std::string_view body = skip_header(file.view());
+
+  auto lob_data = parse_chunked<raw_data::LOBData>(
+      body, pool_.get(), [this](std::string_view chunk) {
+        return parse_lob_chunk(chunk, lob_depth_level_, scale_);
+      });
+
+  logging::Logger::debug("Total LOB entries loaded: ", lob_data.size());
+  return lob_data;
+}
+
+std::vector<raw_data::TradeData>
+MMapCSVParser::parse_trades(const std::string &filename) {
+  if (is_gzip_file(filename)) {
+    auto trades = parse_stream<raw_data::TradeData>(
+        filename, [this](std::string_view line, raw_data::TradeData &trade) {
+          return line_parsers::parse_trade_line(line, scale_, trade);
+        });
+    logging::Logger::debug("Total trades loaded: ", trades.size());
+    return trades;
+  }
+
+  const MappedFile file(filename);
+  const std::string_view body = skip_header(file.view());
+
+  auto trades = parse_chunked<raw_data::TradeData>(
+      body, pool_.get(), [this](std::string_view chunk) {
+        return parse_trades_chunk(chunk, scale_);
+      });
+
+  logging::Logger::debug("Total trades loaded: ", trades.size());
+  return trades;
+}
+} // namespace data_loading
@@ -0,0 +1,214 @@
+#include "execution/multi_strategy_engine.hpp"
+#include "logging.hpp"
+#include <algorithm>
+#include <barrier>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <thread>
+
+namespace execution {
+
+std::size_t
+MultiStrategyEngine::add_strategy(vault::StrategyBase::UPtr &&p_strategy,
+                                  const vault::Portfolio::SPtr &portfolio) {
+  StrategyLane &lane = lanes_.emplace_back();
+  lane.set_strategy(std::move(p_strategy));
+  lane.set_portfolio(portfolio);
+  return lanes_.size() - 1;
+}
+
+bool MultiStrategyEngine::run() {
+  return run(std::numeric_limits<long long>::min(),
+             std::numeric_limits<long long>::max());
+}
+
+bool MultiStrategyEngine::run(long long from_ts, long long to_ts) {
+  if (lanes_.empty()) {
+    logging::Logger::debug("[MULTI] No strategy set.");
+    return false;
+  }
+
+  if (data_source_ == nullptr) {
+    logging::Logger::debug("[MULTI] No data source set.");
+    return false;
+  }
+
+  for (auto &lane : lanes_) {
+    if (!lane.ready()) {
+      logging::Logger::debug("[MULTI] Strategy or portfolio missing.");
+      return false;
+    }
+    lane.set_scale(scale_);
+  }
+
+  data_loading::EventStream stream;
+  stream.add_source(
+      data_loading::create_event_source<data_loading::SnapshotEventSource>(
+          *data_source_));
+  if (trade_source_ != nullptr) {
+    stream.add_source(
+        data_loading::create_event_source<data_loading::TradeEventSource>(
+            *trade_source_));
+  }
+
+  // A fresh source starting from the beginning needs no seek.
+  if ((read_ || from_ts != std::numeric_limits<long long>::min()) &&
+      !stream.seek(from_ts)) {
+    if (read_) {
+      logging::Logger::debug("[MULTI] Source cannot seek, already read.");
+      return false;
+    }
+    logging::Logger::debug("[MULTI] Source cannot seek, skipping to ",
+                           from_ts);
+  }
+  read_ = true;
+
+  std::size_t threads = threads_;
+  if (threads == 0) {
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  threads = std::min(threads, lanes_.size());
+
+  logging::Logger::debug("[MULTI] Starting backtest of ", lanes_.size(),
+                         " strategies on ", threads, " threads.\n");
+
+  return threads <= 1 ? run_serial(stream, from_ts, to_ts)
+                      : run_parallel(stream, from_ts, to_ts, threads);
+}
+
+bool MultiStrategyEngine::advance(data_loading::EventStream &stream,
+                                  long long from_ts, long long to_ts,
+                                  Step &step) {
+  while (const data_loading::MarketEvent *event = stream.next()) {
+    if (event->local_timestamp < from_ts) {
+      continue;
+    }
+    if (event->local_timestamp >= to_ts) {
+      return false;
+    }
+
+    step.event = event;
+    if (event->type == data_loading::EventType::Snapshot) {
+      logging::Logger::debug("[MULTI] Tick ts=", event->local_timestamp);
+      // Orders placed on trades need the snapshot after its source moved on,
+      // unless the source keeps it.
+      if (trade_source_ != nullptr && !data_source_->retains_snapshots()) {
+        book_ = *event->snapshot;
+        step.book = &book_;
+      } else {
+        step.book = event->snapshot;
+      }
+    }
+    return true;
+  }
+  return false;
+}
+
+void MultiStrategyEngine::process(StrategyLane &lane, const Step &step,
+                                  const BookFeatures &features) {
+  if (step.event->type == data_loading::EventType::Trade) {
+    lane.on_trade(*step.event->trade, step.event->local_timestamp,
+                  step.book != nullptr ? &features : nullptr);
+    return;
+  }
+  // A one-sided snapshot ends the run once every lane has processed it.
+  lane.on_snapshot(*step.book, features);
+}
+
+bool MultiStrategyEngine::run_serial(data_loading::EventStream &stream,
+                                     long long from_ts, long long to_ts) {
+  BookFeatures features(scale_);
+  Step step;
+  while (advance(stream, from_ts, to_ts, step)) {
+    const bool snapshot =
+        step.event->type == data_loading::EventType::Snapshot;
+    if (snapshot) {
+      features.reset(*step.book);
+    }
+    for (auto &lane : lanes_) {
+      process(lane, step, features);
+    }
+    if (snapshot && !features.two_sided()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool MultiStrategyEngine::run_parallel(data_loading::EventStream &stream,
+                                       long long from_ts, long long to_ts,
+                                       std::size_t threads) {
+  // Written by the calling thread only while the others wait at the
+  // barrier, read by all of them between the two waits of an event.
+  Step step;
+  bool stop{false};
+  bool completed{true};
+
+  std::exception_ptr error;
+  std::mutex error_mutex;
+  std::barrier sync(static_cast<std::ptrdiff_t>(threads));
+
+  // Thread `t` processes lanes t, t + threads, ...
+  auto process_share = [&](std::size_t t, BookFeatures &features) {
+    if (step.event->type == data_loading::EventType::Snapshot) {
+      features.reset(*step.book);
+    }
+    try {
+      for (std::size_t i = t; i < lanes_.size(); i += threads) {
+        process(lanes_[i], step, features);
+      }
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(error_mutex);
+      if (!error) {
+        error = std::current_exception();
+      }
+    }
+  };
+
+  std::vector<std::thread> workers;
+  workers.reserve(threads - 1);
+  for (std::size_t t = 1; t < threads; ++t) {
+    workers.emplace_back([&, t]() {
+      BookFeatures features(scale_);
+      while (true) {
+        sync.arrive_and_wait();
+        if (stop) {
+          return;
+        }
+        process_share(t, features);
+        sync.arrive_and_wait();
+      }
+    });
+  }
+
+  BookFeatures features(scale_);
+  while (true) {
+    try {
+      stop = error || !completed || !advance(stream, from_ts, to_ts, step);
+    } catch (...) {
+      error = std::current_exception();
+      stop = true;
+    }
+    sync.arrive_and_wait();
+    if (stop) {
+      break;
+    }
+    process_share(0, features);
+    sync.arrive_and_wait();
+    if (step.event->type == data_loading::EventType::Snapshot &&
+        !features.two_sided()) {
+      completed = false;
+    }
+  }
+
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+  return completed;
+}
+
+} // namespace execution
@@ -2,15 +2,50 @@
 #include "logging.hpp"
 #include <algorithm>
 
+namespace {
+/**
+ * @brief Builds the fills of taking up to `remaining` from the first
+ * `levels` levels of a book side.
+ *
+ * @param side Book side walked by the order.
+ * @param levels Number of leading levels that may be taken.
+ * @param remaining Amount to take; on return the part left unfilled.
+ * @param tag Log prefix of the executor.
+ */
+std::vector<common_types::ExecutionFill>
+take_levels(const raw_data::BookSide &side, std::size_t levels,
+            common_types::Amount &remaining, const char *tag) {
+  std::vector<common_types::ExecutionFill> fills;
+  fills.reserve(levels);
+  const common_types::Price *prices = side.prices();
+  const common_types::Amount *amounts = side.amounts();
+  for (std::size_t i = 0; i < levels && remaining > 0; ++i) {
+    const common_types::Amount amount_to_take =
+        std::min(remaining, amounts[i]);
+    fills.push_back({amount_to_take, prices[i]});
+    logging::Logger::debug(tag, " Fill: amount=", amount_to_take,
+                           " @ price=", prices[i]);
+    remaining -= amount_to_take;
+  }
+  return fills;
+}
+} // namespace
+
 namespace execution::orders {
 
 std::vector<common_types::ExecutionFill>
 OrderExecutorAbstract::execute_order(const common_types::Order &order,
                                      const raw_data::LOBData &data) {
+  return execute_order(order, BookFeatures(data));
+}
+
+std::vector<common_types::ExecutionFill>
+OrderExecutorAbstract::execute_order(const common_types::Order &order,
+                                     const BookFeatures &features) {
   if (order.side == common_types::Side::Buy) {
-    return execute_buy_order(order, data);
+    return execute_buy_order(order, features);
   } else if (order.side == common_types::Side::Sell) {
-    return execute_sell_order(order, data);
+    return execute_sell_order(order, features);
   }
   logging::Logger::debug("[EXEC] no fills");
   return {};
@@ -18,7 +53,8 @@ OrderExecutorAbstract::execute_order(const common_types::Order &order,
 
 std::vector<common_types::ExecutionFill>
 LimitFokOrderExecutor::execute_buy_order(const common_types::Order &order,
-                                         const raw_data::LOBData &data) {
+                                         const BookFeatures &features) {
+  const raw_data::LOBData &data = features.data();
   logging::Logger::debug("[EXEC] FOK BUY amount=", order.amount,
                          " at price<=", order.price);
 
@@ -27,38 +63,24 @@ LimitFokOrderExecutor::execute_buy_order(const common_types::Order &order,
     return {};
   }
 
-  double available_amount = 0;
-  for (const auto &ask : data.asks) {
-    if (ask.price > order.price)
-      break;
-    available_amount += ask.amount;
-    if (available_amount >= order.amount)
-      break;
-  }
-
-  if (available_amount < order.amount) {
+  const std::size_t levels =
+      features.levels_within(order.price, common_types::Side::Buy);
+  const std::size_t last =
+      features.exhaust_level(common_types::Side::Buy, levels, order.amount);
+  if (last == levels) {
     logging::Logger::debug("[EXEC][FOK BUY] Not enough liquidity. No fill.");
     return {};
   }
 
-  std::vector<common_types::ExecutionFill> fills;
-  double remaining_amount = order.amount;
-
-  for (const auto &ask : data.asks) {
-    if (ask.price > order.price || remaining_amount <= 0)
-      break;
-
-    double amount_to_take = std::min(remaining_amount, ask.amount);
-    fills.push_back({amount_to_take, ask.price});
-    remaining_amount -= amount_to_take;
-  }
-
-  return fills;
+  common_types::Amount remaining_amount = order.amount;
+  return take_levels(data.asks, last + 1, remaining_amount,
+                     "[EXEC][FOK BUY]");
 }
 
 std::vector<common_types::ExecutionFill>
 LimitFokOrderExecutor::execute_sell_order(const common_types::Order &order,
-                                          const raw_data::LOBData &data) {
+                                          const BookFeatures &features) {
+  const raw_data::LOBData &data = features.data();
   logging::Logger::debug("[EXEC] FOK SELL amount=", order.amount,
                          " at price>=", order.price);
 
@@ -67,41 +89,24 @@ LimitFokOrderExecutor::execute_sell_order(const common_types::Order &order,
     return {};
   }
 
-  double available_amount = 0;
-  for (const auto &bid : data.bids) {
-    if (bid.price < order.price)
-      break;
-    available_amount += bid.amount;
-    if (available_amount >= order.amount)
-      break;
-  }
-
-  if (available_amount < order.amount) {
+  const std::size_t levels =
+      features.levels_within(order.price, common_types::Side::Sell);
+  const std::size_t last =
+      features.exhaust_level(common_types::Side::Sell, levels, order.amount);
+  if (last == levels) {
     logging::Logger::debug("[EXEC][FOK SELL] Not enough liquidity. No fill.");
     return {};
   }
 
-  std::vector<common_types::ExecutionFill> fills;
-  double remaining_amount = order.amount;
-
-  for (const auto &bid : data.bids) {
-    if (bid.price < order.price || remaining_amount <= 0)
-      break;
-
-    double amount_to_take = std::min(remaining_amount, bid.amount);
-    fills.push_back({amount_to_take, bid.price});
-    logging::Logger::debug("[EXEC][FOK SELL] Fill: amount=", amount_to_take,
-                           " @ price=", bid.price);
-    remaining_amount -= amount_to_take;
-  }
-
-  return fills;
+  common_types::Amount remaining_amount = order.amount;
+  return take_levels(data.bids, last + 1, remaining_amount,
+                     "[EXEC][FOK SELL]");
 }
 
 std::vector<common_types::ExecutionFill>
 LimitIocOrderExecutor::execute_buy_order(const common_types::Order &order,
-                                         const raw_data::LOBData &data) {
-  std::vector<common_types::ExecutionFill> fills;
+                                         const BookFeatures &features) {
+  const raw_data::LOBData &data = features.data();
   logging::Logger::debug("[EXEC] IOC BUY amount=", order.amount,
                          " at price<=", order.price);
 
@@ -110,14 +115,14 @@ LimitIocOrderExecutor::execute_buy_order(const common_types::Order &order,
     return {};
   }
 
-  double remaining_amount = order.amount;
-  for (const auto &ask : data.asks) {
-    if (ask.price > order.price || remaining_amount <= 0)
-      break;
-    double amount_to_take = std::min(remaining_amount, ask.amount);
-    fills.push_back({amount_to_take, ask.price});
-    remaining_amount -= amount_to_take;
-  }
+  const std::size_t levels =
+      features.levels_within(order.price, common_types::Side::Buy);
+  const std::size_t last =
+      features.exhaust_level(common_types::Side::Buy, levels, order.amount);
+
+  common_types::Amount remaining_amount = order.amount;
+  auto fills = take_levels(data.asks, std::min(last + 1, levels),
+                           remaining_amount, "[EXEC][IOC BUY]");
 
   if (remaining_amount > 0) {
     logging::Logger::debug("[EXEC][IOC BUY] Partial fill. Remaining=",
@@ -129,8 +134,8 @@ LimitIocOrderExecutor::execute_buy_order(const common_types::Order &order,
 
 std::vector<common_types::ExecutionFill>
 LimitIocOrderExecutor::execute_sell_order(const common_types::Order &order,
-                                          const raw_data::LOBData &data) {
-  std::vector<common_types::ExecutionFill> fills;
+                                          const BookFeatures &features) {
+  const raw_data::LOBData &data = features.data();
   logging::Logger::debug("[EXEC] IOC SELL amount=", order.amount,
                          " at price>=", order.price);
 
@@ -139,16 +144,14 @@ LimitIocOrderExecutor::execute_sell_order(const common_types::Order &order,
     return {};
   }
 
-  double remaining_amount = order.amount;
-  for (const auto &bid : data.bids) {
-    if (bid.price < order.price || remaining_amount <= 0)
-      break;
-    double amount_to_take = std::min(remaining_amount, bid.amount);
-    fills.push_back({amount_to_take, bid.price});
-    logging::Logger::debug("[EXEC][IOC SELL] Fill: amount=", amount_to_take,
-                           " @ price=", bid.price);
-    remaining_amount -= amount_to_take;
-  }
+  const std::size_t levels =
+      features.levels_within(order.price, common_types::Side::Sell);
+  const std::size_t last =
+      features.exhaust_level(common_types::Side::Sell, levels, order.amount);
+
+  common_types::Amount remaining_amount = order.amount;
+  auto fills = take_levels(data.bids, std::min(last + 1, levels),
+                           remaining_amount, "[EXEC][IOC SELL]");
 
   if (remaining_amount > 0) {
     logging::Logger::debug("[EXEC][IOC SELL] Partial fill. Remaining=",
@@ -160,8 +163,8 @@ LimitIocOrderExecutor::execute_sell_order(const common_types::Order &order,
 
 std::vector<common_types::ExecutionFill>
 MarketOrderExecutor::execute_buy_order(const common_types::Order &order,
-                                       const raw_data::LOBData &data) {
-  std::vector<common_types::ExecutionFill> fills;
+                                       const BookFeatures &features) {
+  const raw_data::LOBData &data = features.data();
   logging::Logger::debug("[EXEC] MARKET BUY amount=", order.amount);
 
   if (data.asks.empty()) {
@@ -169,31 +172,26 @@ MarketOrderExecutor::execute_buy_order(const common_types::Order &order,
     return {};
   }
 
-  double remaining_amount = order.amount;
-  for (const auto &ask : data.asks) {
-    if (remaining_amount <= 0)
-      break;
-    double amount_to_take = std::min(remaining_amount, ask.amount);
-    fills.push_back({amount_to_take, ask.price});
-    logging::Logger::debug("[EXEC][MARKET BUY] Fill: amount=", amount_to_take,
-                           " @ price=", ask.price);
-    remaining_amount -= amount_to_take;
-  }
-
-  if (remaining_amount > 0) {
+  const std::size_t levels = data.asks.size();
+  const std::size_t last =
+      features.exhaust_level(common_types::Side::Buy, levels, order.amount);
+  if (last == levels) {
     logging::Logger::debug(
         "[EXEC][MARKET BUY] Not enough liquidity. Order unfilled.");
     return {};
   }
 
+  common_types::Amount remaining_amount = order.amount;
+  auto fills = take_levels(data.asks, last + 1, remaining_amount,
+                           "[EXEC][MARKET BUY]");
   logging::Logger::debug("[EXEC][MARKET BUY] Order fully executed.");
   return fills;
 }
 
 std::vector<common_types::ExecutionFill>
 MarketOrderExecutor::execute_sell_order(const common_types::Order &order,
-                                        const raw_data::LOBData &data) {
-  std::vector<common_types::ExecutionFill> fills;
+                                        const BookFeatures &features) {
+  const raw_data::LOBData &data = features.data();
   logging::Logger::debug("[EXEC] MARKET SELL amount=", order.amount);
 
   if (data.bids.empty()) {
@@ -201,16 +199,13 @@ MarketOrderExecutor::execute_sell_order(const common_types::Order &order,
     return {};
   }
 
-  double remaining_amount = order.amount;
-  for (const auto &bid : data.bids) {
-    if (remaining_amount <= 0)
-      break;
-    double amount_to_take = std::min(remaining_amount, bid.amount);
-    fills.push_back({amount_to_take, bid.price});
-    logging::Logger::debug("[EXEC][MARKET SELL] Fill: amount=", amount_to_take,
-                           " @ price=", bid.price);
-    remaining_amount -= amount_to_take;
-  }
+  const std::size_t levels = data.bids.size();
+  const std::size_t last =
+      features.exhaust_level(common_types::Side::Sell, levels, order.amount);
+
+  common_types::Amount remaining_amount = order.amount;
+  auto fills = take_levels(data.bids, std::min(last + 1, levels),
+                           remaining_amount, "[EXEC][MARKET SELL]");
 
   if (remaining_amount > 0) {
     logging::Logger::debug(
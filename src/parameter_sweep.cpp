@@ -0,0 +1,126 @@
+#include "execution/parameter_sweep.hpp"
+#include "data_loader/trade_data_source.hpp"
+#include "execution/backtesing_engine.hpp"
+#include "logging.hpp"
+#include "metrics/metrics_calculator.hpp"
+#include "utils/thread_pool.hpp"
+#include "vaults/portfolio.hpp"
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <stdexcept>
+
+namespace execution {
+ParameterGrid &ParameterGrid::add(const std::string &name,
+                                  std::vector<double> values) {
+  if (values.empty()) {
+    throw std::invalid_argument("Parameter '" + name + "' has no values");
+  }
+  const bool taken =
+      std::any_of(axes_.begin(), axes_.end(),
+                  [&](const auto &axis) { return axis.first == name; });
+  if (taken) {
+    throw std::invalid_argument("Parameter '" + name + "' is already in grid");
+  }
+  axes_.emplace_back(name, std::move(values));
+  return *this;
+}
+
+std::size_t ParameterGrid::size() const noexcept {
+  std::size_t combinations = 1;
+  for (const auto &axis : axes_) {
+    combinations *= axis.second.size();
+  }
+  return combinations;
+}
+
+ParameterSet ParameterGrid::at(std::size_t i) const {
+  if (i >= size()) {
+    throw std::out_of_range("Parameter combination index out of range");
+  }
+  ParameterSet parameters;
+  for (auto axis = axes_.rbegin(); axis != axes_.rend(); ++axis) {
+    const auto &values = axis->second;
+    parameters.emplace(axis->first, values[i % values.size()]);
+    i /= values.size();
+  }
+  return parameters;
+}
+
+ParameterSweep::ParameterSweep(
+    std::shared_ptr<const std::vector<raw_data::LOBData>> lob_data)
+    : make_source_([lob_data = std::move(lob_data)]() {
+        return data_loading::create_data_source<
+            data_loading::InMemoryDataSource>(lob_data);
+      }) {}
+
+ParameterSweep::ParameterSweep(
+    std::shared_ptr<const data_loading::LOBArena> arena)
+    : make_source_([arena = std::move(arena)]() {
+        return data_loading::create_data_source<data_loading::ArenaDataSource>(
+            arena);
+      }) {}
+
+std::vector<SweepResult> ParameterSweep::run(const ParameterGrid &grid,
+                                             const StrategyFactory &factory,
+                                             std::size_t threads) const {
+  const std::size_t combinations = grid.size();
+  std::vector<SweepResult> results(combinations);
+
+  utils::ThreadPool pool(threads);
+  const std::size_t workers = std::min(pool.size(), combinations);
+  logging::Logger::debug("[SWEEP] ", combinations, " combinations on ",
+                         workers, " threads");
+
+  std::atomic<std::size_t> next{0};
+  std::vector<std::future<void>> done;
+  done.reserve(workers);
+  for (std::size_t w = 0; w < workers; ++w) {
+    done.push_back(pool.submit([&]() {
+      for (std::size_t i = next.fetch_add(1, std::memory_order_relaxed);
+           i < combinations;
+           i = next.fetch_add(1, std::memory_order_relaxed)) {
+        results[i] = run_one(grid.at(i), factory);
+      }
+    }));
+  }
+
+  // Every worker must be done with `results` before an error unwinds it.
+  for (auto &worker : done) {
+    worker.wait();
+  }
+  for (auto &worker : done) {
+    worker.get();
+  }
+  return results;
+}
+
+SweepResult ParameterSweep::run_one(const ParameterSet &parameters,
+                                    const StrategyFactory &factory) const {
+  SweepResult result;
+  result.parameters = parameters;
+
+  auto portfolio = vault::Portfolio::create_portfolio();
+  portfolio->set_cash(initial_cash_);
+  portfolio->set_amount(initial_amount_);
+
+  BacktestEngine engine;
+  engine.link_portfolio(portfolio);
+  engine.set_instrument_scale(scale_);
+  engine.set_data_source(make_source_());
+  if (trades_ != nullptr) {
+    engine.set_trade_source(
+        data_loading::create_trade_source<data_loading::InMemoryTradeSource>(
+            trades_));
+  }
+  engine.set_strategy(factory(parameters));
+  result.completed = engine.run();
+
+  vault::stats::MetricsCalculator metrics_calculator;
+  if (metrics_setup_) {
+    metrics_setup_(metrics_calculator);
+  }
+  result.metrics = metrics_calculator.calculate_all_metrics(*portfolio);
+  return result;
+}
+} // namespace execution
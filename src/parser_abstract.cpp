@@ -0,0 +1,23 @@
+#include "data_loader/parser_abstract.hpp"
+#include <future>
+
+namespace data_loading {
+MarketData ParserAbstract::load(const std::string &lob_filename,
+                                const std::string &trades_filename) {
+  MarketData data;
+
+  std::future<std::vector<raw_data::TradeData>> trades_future;
+  if (!trades_filename.empty()) {
+    trades_future = std::async(std::launch::async, [&]() {
+      return parse_trades(trades_filename);
+    });
+  }
+
+  data.lob = parse_lob(lob_filename);
+  if (trades_future.valid()) {
+    data.trades = trades_future.get();
+  }
+
+  return data;
+}
+} // namespace data_loading
@@ -2,9 +2,15 @@
 #include "types.hpp"
 
 #include "logging.hpp"
+#include <stdexcept>
 #include <vector>
 
-constexpr double EPS_D = 1e-10;
+#ifdef HFT_TASK_FIXED_POINT
+/// Lots are exact integers: a lot is exhausted only when nothing is left.
+constexpr common_types::Amount EPS_AMOUNT = 0;
+#else
+constexpr common_types::Amount EPS_AMOUNT = 1e-10;
+#endif
 
 namespace vault {
 Portfolio::Portfolio(const double initial_cash, const double initial_amount) {
@@ -12,27 +18,44 @@ Portfolio::Portfolio(const double initial_cash, const double initial_amount) {
   set_amount(initial_amount);
 }
 
+void Portfolio::set_scale(const common_types::InstrumentScale &scale) {
+  if (scale == scale_) {
+    return;
+  }
+  if (!trade_history_.empty()) {
+    throw std::runtime_error(
+        "Portfolio scale cannot be changed after trades were made");
+  }
+  const double cash = get_cash_amount();
+  const double amount = get_asset_amount();
+  scale_ = scale;
+  set_cash(cash);
+  set_amount(amount);
+}
+
 bool Portfolio::can_buy(
     const std::vector<common_types::ExecutionFill> &fills) const noexcept {
-  double total_cost = 0.0;
+  common_types::Notional total_cost{};
   for (const auto &f : fills) {
-    total_cost += f.amount * f.price;
+    total_cost += common_types::notional(f.price, f.amount);
   }
   logging::Logger::debug(
-      "[PORTFOLIO] Can buy? Need=", std::to_string(total_cost),
-      " Cash=", std::to_string(cash_));
+      "[PORTFOLIO] Can buy? Need=",
+      std::to_string(scale_.from_notional(total_cost)),
+      " Cash=", std::to_string(get_cash_amount()));
   return cash_ >= total_cost;
 }
 
 bool Portfolio::can_sell(
     const std::vector<common_types::ExecutionFill> &fills) const noexcept {
-  double total_amount = 0.0;
+  common_types::Amount total_amount{};
   for (const auto &f : fills) {
     total_amount += f.amount;
   }
   logging::Logger::debug(
-      "[PORTFOLIO] Can sell? Need=", std::to_string(total_amount),
-      " Assets=", std::to_string(asset_amount_));
+      "[PORTFOLIO] Can sell? Need=",
+      std::to_string(scale_.from_amount(total_amount)),
+      " Assets=", std::to_string(get_asset_amount()));
   return asset_amount_ >= total_amount;
 }
 
@@ -42,14 +65,16 @@ void Portfolio::update_after_buy(
     common_types::Lot l{f.price, f.amount};
     positions_.push_back(l);
 
-    cash_ -= f.amount * f.price;
+    cash_ -= common_types::notional(f.price, f.amount);
     asset_amount_ += f.amount;
-    trade_history_.push_back({common_types::Side::Buy, l, .0});
+    trade_history_.push_back({common_types::Side::Buy, l, {}});
 
     logging::Logger::debug(
-        "[PORTFOLIO][BUY] Bought amount=", std::to_string(f.amount), " @ ",
-        std::to_string(f.price), " Cash now=", std::to_string(cash_),
-        " Assets now=", std::to_string(asset_amount_));
+        "[PORTFOLIO][BUY] Bought amount=",
+        std::to_string(scale_.from_amount(f.amount)), " @ ",
+        std::to_string(scale_.from_price(f.price)),
+        " Cash now=", std::to_string(get_cash_amount()),
+        " Assets now=", std::to_string(get_asset_amount()));
   }
 }
 
@@ -58,16 +83,18 @@ void Portfolio::update_after_sell(
   for (const auto &f : fills) {
     const auto realized_pnl = calculate_realized_pnl(f.amount, f.price);
 
-    cash_ += f.amount * f.price;
+    cash_ += common_types::notional(f.price, f.amount);
     asset_amount_ -= f.amount;
     trade_history_.push_back(
         {common_types::Side::Sell, {f.price, f.amount}, realized_pnl});
 
     logging::Logger::debug(
-        "[PORTFOLIO][SELL] Sold amount=", std::to_string(f.amount), " @ ",
-        std::to_string(f.price), " Cash now=", std::to_string(cash_),
-        " Assets now=", std::to_string(asset_amount_),
-        " RealizedPnL=", std::to_string(realized_pnl));
+        "[PORTFOLIO][SELL] Sold amount=",
+        std::to_string(scale_.from_amount(f.amount)), " @ ",
+        std::to_string(scale_.from_price(f.price)),
+        " Cash now=", std::to_string(get_cash_amount()),
+        " Assets now=", std::to_string(get_asset_amount()),
+        " RealizedPnL=", std::to_string(scale_.from_notional(realized_pnl)));
   }
 }
 
@@ -76,33 +103,39 @@ std::vector<common_types::Lot> Portfolio::get_all_positions() const {
 }
 
 void Portfolio::update_portfolio_value(const double current_price) {
-  double current_value = cash_ + asset_amount_ * current_price;
+  double current_value = get_current_portfolio_value(current_price);
   portfolio_values_.push_back(current_value);
 }
 
-double Portfolio::calculate_realized_pnl(double amount, double sell_price) {
-  double realised_pnl{.0};
+common_types::Notional
+Portfolio::calculate_realized_pnl(common_types::Amount amount,
+                                  common_types::Price sell_price) {
+  common_types::Notional realised_pnl{};
 
   while (amount > 0 && !positions_.empty()) {
     auto &front_lot = positions_.front();
-    double sell_from_this_lot = std::min(amount, front_lot.amount);
+    common_types::Amount sell_from_this_lot =
+        std::min(amount, front_lot.amount);
 
-    double lot_pnl = (sell_price - front_lot.entry_price) * sell_from_this_lot;
+    common_types::Notional lot_pnl = common_types::notional(
+        sell_price - front_lot.entry_price, sell_from_this_lot);
     realised_pnl += lot_pnl;
 
     logging::Logger::debug(
-        "[PORTFOLIO][PNL] Lot entry=", std::to_string(front_lot.entry_price),
-        " Sell=", sell_price, " Amount=", std::to_string(sell_from_this_lot),
-        " PnL=", std::to_string(lot_pnl));
+        "[PORTFOLIO][PNL] Lot entry=",
+        std::to_string(scale_.from_price(front_lot.entry_price)),
+        " Sell=", scale_.from_price(sell_price),
+        " Amount=", std::to_string(scale_.from_amount(sell_from_this_lot)),
+        " PnL=", std::to_string(scale_.from_notional(lot_pnl)));
 
     front_lot.amount -= sell_from_this_lot;
     amount -= sell_from_this_lot;
 
-    if (front_lot.amount <= EPS_D) {
+    if (front_lot.amount <= EPS_AMOUNT) {
       positions_.pop_front();
     }
   }
 
   return realised_pnl;
 }
-} // namespace vault
\ No newline at end of file
+} // namespace vault
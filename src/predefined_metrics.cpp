@@ -10,7 +10,7 @@ namespace vault::stats::prerefined {
 PnL::PnL(const std::string &name) { name_ = name; }
 
 double PnL::calculate(const Portfolio &portfolio) const {
-  double realized_pnl = .0;
+  common_types::Notional realized_pnl{};
 
   const auto &history = portfolio.get_history();
   for (const auto &trade : history) {
@@ -19,7 +19,7 @@ double PnL::calculate(const Portfolio &portfolio) const {
     }
   }
 
-  return realized_pnl;
+  return portfolio.scale().from_notional(realized_pnl);
 }
 
 MaxDrawdownMetric::MaxDrawdownMetric(const std::string &name) { name_ = name; }
@@ -10,7 +10,7 @@ std::optional<common_types::Order> StrategyFromTradesFile::on_tick() {
     return std::nullopt;
   }
 
-  if (current_data_.local_timestamp >= trade_it_->local_timestamp) {
+  if (current_data().local_timestamp >= trade_it_->local_timestamp) {
     common_types::Order order;
     order.price = trade_it_->price;
     order.amount = trade_it_->amount;
@@ -23,4 +23,14 @@ std::optional<common_types::Order> StrategyFromTradesFile::on_tick() {
 
   return std::nullopt;
 }
+
+std::optional<common_types::Order>
+StrategyFromTradesFeed::on_market_trade(const raw_data::TradeData &trade) {
+  common_types::Order order;
+  order.price = trade.price;
+  order.amount = trade.amount;
+  order.side = trade.side;
+  order.order_type = execution::orders::OrderTypes::LimitIoc;
+  return order;
+}
 } // namespace vault
\ No newline at end of file
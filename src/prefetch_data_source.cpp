@@ -0,0 +1,108 @@
+#include "data_loader/prefetch_data_source.hpp"
+#include "logging.hpp"
+
+namespace data_loading {
+PrefetchDataSource::PrefetchDataSource(MarketDataSource::UPtr &&upstream,
+                                       std::size_t capacity)
+    : upstream_(std::move(upstream)), ring_(capacity) {
+  start();
+}
+
+PrefetchDataSource::~PrefetchDataSource() { stop(); }
+
+void PrefetchDataSource::start() {
+  producer_ = std::thread([this]() { produce(); });
+}
+
+void PrefetchDataSource::stop() {
+  stop_.store(true, std::memory_order_relaxed);
+  if (producer_.joinable()) {
+    producer_.join();
+  }
+  stop_.store(false, std::memory_order_relaxed);
+}
+
+void PrefetchDataSource::produce() {
+  try {
+    if (has_stashed_) {
+      if (!publish(stashed_)) {
+        return;
+      }
+      has_stashed_ = false;
+    }
+    while (const raw_data::LOBData *snapshot = upstream_->next()) {
+      if (!publish(*snapshot)) {
+        // Keep the snapshot so a restarted producer does not lose it.
+        stashed_ = *snapshot;
+        has_stashed_ = true;
+        return;
+      }
+    }
+  } catch (...) {
+    error_ = std::current_exception();
+  }
+  done_.store(true, std::memory_order_release);
+}
+
+bool PrefetchDataSource::publish(const raw_data::LOBData &snapshot) {
+  raw_data::LOBData *slot = nullptr;
+  while ((slot = ring_.write_slot()) == nullptr) {
+    if (stop_.load(std::memory_order_relaxed)) {
+      return false;
+    }
+    std::this_thread::yield();
+  }
+  *slot = snapshot;
+  ring_.commit_write();
+  return true;
+}
+
+bool PrefetchDataSource::seek(long long timestamp) {
+  stop();
+
+  const bool moved = upstream_->seek(timestamp);
+  if (moved) {
+    if (holding_slot_) {
+      ring_.release_read();
+      holding_slot_ = false;
+    }
+    while (ring_.read_slot() != nullptr) {
+      ring_.release_read();
+    }
+    has_stashed_ = false;
+    error_ = nullptr;
+    done_.store(false, std::memory_order_relaxed);
+  }
+
+  if (!done_.load(std::memory_order_relaxed)) {
+    start();
+  }
+  return moved;
+}
+
+const raw_data::LOBData *PrefetchDataSource::next() {
+  if (holding_slot_) {
+    ring_.release_read();
+    holding_slot_ = false;
+  }
+
+  while (true) {
+    if (raw_data::LOBData *slot = ring_.read_slot()) {
+      holding_slot_ = true;
+      return slot;
+    }
+    if (done_.load(std::memory_order_acquire)) {
+      // The producer may have published between the two checks.
+      if (raw_data::LOBData *slot = ring_.read_slot()) {
+        holding_slot_ = true;
+        return slot;
+      }
+      if (error_) {
+        std::rethrow_exception(error_);
+      }
+      return nullptr;
+    }
+    std::this_thread::yield();
+  }
+}
+} // namespace data_loading
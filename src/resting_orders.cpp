@@ -0,0 +1,304 @@
+#include "execution/resting_orders.hpp"
+#include "logging.hpp"
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <utility>
+
+namespace {
+/// Returns the amount displayed at `price` on the `side` half of the book.
+common_types::Amount displayed_at(const raw_data::LOBData &data,
+                                  common_types::Side side,
+                                  common_types::Price price) {
+  const bool buy = side == common_types::Side::Buy;
+  const raw_data::BookSide &book = buy ? data.bids : data.asks;
+  const common_types::Price *first = book.prices();
+  const common_types::Price *last = first + book.size();
+  // Bids are sorted by descending price, asks by ascending price.
+  const common_types::Price *it =
+      buy ? std::lower_bound(first, last, price,
+                             [](common_types::Price level,
+                                common_types::Price p) { return level > p; })
+          : std::lower_bound(first, last, price);
+  if (it == last || *it != price) {
+    return common_types::Amount{};
+  }
+  return book.amounts()[it - first];
+}
+} // namespace
+
+namespace execution {
+RestingOrderBook::RestingOrderBook(std::size_t expected_orders)
+    : ids_(expected_orders) {}
+
+RestingOrderBook::Levels::iterator
+RestingOrderBook::locate(common_types::Side side, common_types::Price price) {
+  Levels &side_levels = levels(side);
+  return side_levels.begin() +
+         (std::as_const(*this).locate(side, price) - side_levels.cbegin());
+}
+
+RestingOrderBook::Levels::const_iterator
+RestingOrderBook::locate(common_types::Side side,
+                         common_types::Price price) const {
+  const Levels &side_levels = levels(side);
+  // Best level last: bids ascend, asks descend.
+  if (side == common_types::Side::Buy) {
+    return std::lower_bound(
+        side_levels.begin(), side_levels.end(), price,
+        [](const Level &level, common_types::Price p) {
+          return level.price < p;
+        });
+  }
+  return std::lower_bound(side_levels.begin(), side_levels.end(), price,
+                          [](const Level &level, common_types::Price p) {
+                            return level.price > p;
+                          });
+}
+
+bool RestingOrderBook::add(const common_types::Order &order,
+                           common_types::Amount amount,
+                           const BookFeatures &features,
+                           common_types::Amount crossed) {
+  if (order.side == common_types::Side::Undefined ||
+      !ids_.insert(order.id, {order.price, order.side})) {
+    return false;
+  }
+
+  const common_types::Amount displayed =
+      displayed_at(features.data(), order.side, order.price);
+  auto it = locate(order.side, order.price);
+  if (it == levels(order.side).end() || it->price != order.price) {
+    it = levels(order.side).insert(it, Level{order.price, displayed,
+                                             common_types::Amount{}, crossed,
+                                             {}});
+  }
+  // Liquidity taken by an own order of the level counts once.
+  it->crossed = std::max(it->crossed, crossed);
+
+  // Everything displayed now and not already ahead of an own order is
+  // ahead of the new one.
+  common_types::Amount ahead{};
+  for (const auto &resting : it->orders) {
+    ahead += resting.gap;
+  }
+  it->orders.push_back(
+      {order, amount,
+       displayed > ahead ? displayed - ahead : common_types::Amount{}});
+
+  logging::Logger::debug("[RESTING] Order id=", order.id,
+                         " rests amount=", amount, " @ ", order.price,
+                         " behind ", displayed);
+  return true;
+}
+
+bool RestingOrderBook::cancel(std::uint64_t id) {
+  const Location *location = ids_.find(id);
+  if (location == nullptr) {
+    return false;
+  }
+  Levels &side_levels = levels(location->side);
+  const auto level = locate(location->side, location->price);
+  auto &orders = level->orders;
+  const auto it =
+      std::find_if(orders.begin(), orders.end(), [id](const Resting &resting) {
+        return resting.order.id == id;
+      });
+  // The displayed amount ahead of the order stays ahead of the next one.
+  if (std::next(it) != orders.end()) {
+    std::next(it)->gap += it->gap;
+  }
+  orders.erase(it);
+  if (orders.empty()) {
+    side_levels.erase(level);
+  }
+  ids_.erase(id);
+  return true;
+}
+
+common_types::Amount
+RestingOrderBook::crossed(common_types::Side side, common_types::Price price,
+                          const BookFeatures &features) const {
+  const std::size_t within = features.levels_within(price, side);
+  const common_types::Amount depth = side == common_types::Side::Buy
+                                         ? features.ask_depth(within)
+                                         : features.bid_depth(within);
+  // Like on_snapshot(), the best levels are assumed taken first.
+  common_types::Amount taken{};
+  for (const auto &level : levels(side)) {
+    taken = std::max(taken, level.crossed);
+  }
+  return std::min(taken, depth);
+}
+
+bool RestingOrderBook::queue_ahead(std::uint64_t id,
+                                   common_types::Amount &ahead) const {
+  const Location *location = ids_.find(id);
+  if (location == nullptr) {
+    return false;
+  }
+  const auto level = locate(location->side, location->price);
+  ahead = common_types::Amount{};
+  for (const auto &resting : level->orders) {
+    ahead += resting.gap;
+    if (resting.order.id == id) {
+      break;
+    }
+    ahead += resting.remaining;
+  }
+  return true;
+}
+
+void RestingOrderBook::on_snapshot(const BookFeatures &features,
+                                   std::vector<Fill> &fills) {
+  for (const auto side : {common_types::Side::Buy, common_types::Side::Sell}) {
+    Levels &side_levels = levels(side);
+    if (side_levels.empty()) {
+      continue;
+    }
+
+    for (auto &level : side_levels) {
+      const common_types::Amount displayed =
+          displayed_at(features.data(), side, level.price);
+      // A decrease not explained by the trades already seen at the level
+      // is orders ahead leaving the queue.
+      const common_types::Amount decrease = level.displayed - displayed;
+      if (decrease > level.traded) {
+        consume(level, decrease - level.traded, false, fills);
+      }
+      // Never more queued ahead than is displayed.
+      common_types::Amount ahead{};
+      for (auto &resting : level.orders) {
+        resting.gap = std::clamp(displayed - ahead, common_types::Amount{},
+                                 resting.gap);
+        ahead += resting.gap;
+      }
+      level.displayed = displayed;
+      level.traded = common_types::Amount{};
+    }
+
+    // Opposite liquidity at or through an own level trades with it; the
+    // best own level takes it first. Only depth beyond what the level, or a
+    // better one, already took is new: what is gone from the book is no
+    // longer counted, so liquidity that returns fills again.
+    common_types::Amount used{};
+    // Index of the worst level that filled.
+    std::size_t first = side_levels.size();
+    for (auto level = side_levels.rbegin(); level != side_levels.rend();
+         ++level) {
+      const std::size_t crossed = features.levels_within(level->price, side);
+      const common_types::Amount depth =
+          side == common_types::Side::Buy ? features.ask_depth(crossed)
+                                          : features.bid_depth(crossed);
+      level->crossed = std::min(std::max(level->crossed, used), depth);
+      if (depth > level->crossed) {
+        const common_types::Amount filled =
+            sweep(*level, depth - level->crossed, fills);
+        if (filled > 0) {
+          level->crossed += filled;
+          first = static_cast<std::size_t>(
+              std::prev(level.base()) - side_levels.begin());
+        }
+      }
+      used = std::max(used, level->crossed);
+    }
+    if (first != side_levels.size()) {
+      compact(side, first);
+    }
+  }
+}
+
+void RestingOrderBook::on_trade(const raw_data::TradeData &trade,
+                                std::vector<Fill> &fills) {
+  if (trade.side == common_types::Side::Undefined) {
+    return;
+  }
+  // A sell aggressor trades with resting buy orders and vice versa.
+  const common_types::Side side = trade.side == common_types::Side::Sell
+                                      ? common_types::Side::Buy
+                                      : common_types::Side::Sell;
+  Levels &side_levels = levels(side);
+  const std::size_t filled = fills.size();
+  auto level = side_levels.rbegin();
+  for (; level != side_levels.rend(); ++level) {
+    const bool through = side == common_types::Side::Buy
+                             ? level->price > trade.price
+                             : level->price < trade.price;
+    if (level->price == trade.price) {
+      level->traded += trade.amount;
+      consume(*level, trade.amount, true, fills);
+    } else if (through) {
+      // Printing at a worse price, the aggressor emptied this level.
+      sweep(*level, std::numeric_limits<common_types::Amount>::max(), fills);
+    } else {
+      break;
+    }
+  }
+  // Only the levels the trade reached can have filled orders.
+  if (fills.size() != filled) {
+    compact(side,
+            static_cast<std::size_t>(level.base() - side_levels.begin()));
+  }
+}
+
+void RestingOrderBook::consume(Level &level, common_types::Amount volume,
+                               bool fill, std::vector<Fill> &fills) {
+  for (auto &resting : level.orders) {
+    const common_types::Amount ahead = std::min(volume, resting.gap);
+    resting.gap -= ahead;
+    volume -= ahead;
+    if (volume <= 0) {
+      return;
+    }
+    if (fill && resting.remaining > 0) {
+      const common_types::Amount amount = std::min(volume, resting.remaining);
+      resting.remaining -= amount;
+      volume -= amount;
+      fills.push_back({resting.order, {amount, level.price}});
+    }
+  }
+}
+
+common_types::Amount RestingOrderBook::sweep(Level &level,
+                                             common_types::Amount volume,
+                                             std::vector<Fill> &fills) {
+  common_types::Amount filled{};
+  for (auto &resting : level.orders) {
+    resting.gap = common_types::Amount{};
+    const common_types::Amount amount = std::min(volume, resting.remaining);
+    if (amount > 0) {
+      resting.remaining -= amount;
+      volume -= amount;
+      filled += amount;
+      fills.push_back({resting.order, {amount, level.price}});
+    }
+  }
+  return filled;
+}
+
+void RestingOrderBook::compact(common_types::Side side, std::size_t first) {
+  Levels &side_levels = levels(side);
+  const auto from = side_levels.begin() + first;
+  for (auto level = from; level != side_levels.end(); ++level) {
+    auto &orders = level->orders;
+    auto kept = orders.begin();
+    common_types::Amount carried{};
+    for (auto &resting : orders) {
+      if (resting.remaining > 0) {
+        resting.gap += carried;
+        carried = common_types::Amount{};
+        *kept++ = resting;
+      } else {
+        carried += resting.gap;
+        ids_.erase(resting.order.id);
+      }
+    }
+    orders.erase(kept, orders.end());
+  }
+  side_levels.erase(std::remove_if(from, side_levels.end(),
+                                   [](const Level &level) {
+                                     return level.orders.empty();
+                                   }),
+                    side_levels.end());
+}
+} // namespace execution
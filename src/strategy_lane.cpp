@@ -0,0 +1,5 @@
+#include "execution/strategy_lane.hpp"
+
+namespace execution {
+template class BasicStrategyLane<vault::StrategyBase>;
+} // namespace execution
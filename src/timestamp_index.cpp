@@ -0,0 +1,145 @@
+#include "data_loader/timestamp_index.hpp"
+#include "data_loader/byte_source.hpp"
+#include "data_loader/line_parsers.hpp"
+#include "data_loader/mapped_file.hpp"
+#include "logging.hpp"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string_view>
+
+namespace {
+/// Magic number of index files ("HIDX").
+constexpr std::uint32_t INDEX_MAGIC = 0x58444948;
+/// Current index format version.
+constexpr std::uint32_t INDEX_VERSION = 1;
+
+/// @brief Header at the beginning of an index file.
+struct IndexHeader {
+  std::uint32_t magic{INDEX_MAGIC};     ///< INDEX_MAGIC.
+  std::uint32_t version{INDEX_VERSION}; ///< INDEX_VERSION.
+  std::uint32_t stride{0};              ///< Rows between two entries.
+  std::uint32_t reserved{0};
+  std::uint64_t count{0};     ///< Number of entries.
+  std::uint64_t data_size{0}; ///< Size of the indexed file.
+};
+
+static_assert(sizeof(IndexHeader) == 32, "IndexHeader must stay 32 bytes");
+} // namespace
+
+namespace data_loading {
+TimestampIndex TimestampIndex::build(const std::string &filename,
+                                     std::size_t stride) {
+  if (is_gzip_file(filename)) {
+    throw std::runtime_error("Cannot index a compressed file: " + filename);
+  }
+
+  TimestampIndex index;
+  index.stride_ = std::max<std::size_t>(stride, 1);
+
+  const MappedFile file(filename);
+  index.data_size_ = file.size();
+
+  const std::string_view content = file.view();
+  const std::size_t header_end = content.find('\n');
+  std::size_t pos =
+      (header_end == std::string_view::npos) ? content.size() : header_end + 1;
+
+  std::size_t row = 0;
+  bool want_entry = true;
+  while (pos < content.size()) {
+    const std::size_t eol = content.find('\n', pos);
+    const std::size_t end =
+        (eol == std::string_view::npos) ? content.size() : eol;
+    if (row % index.stride_ == 0) {
+      want_entry = true;
+    }
+
+    long long timestamp = 0;
+    if (want_entry && line_parsers::parse_timestamp(
+                          content.substr(pos, end - pos), timestamp)) {
+      if (!index.entries_.empty() &&
+          timestamp < index.entries_.back().timestamp) {
+        throw std::runtime_error("File is not sorted by timestamp: " +
+                                 filename);
+      }
+      index.entries_.push_back({timestamp, pos});
+      want_entry = false;
+    }
+
+    pos = end + 1;
+    ++row;
+  }
+
+  logging::Logger::debug("[INDEX] Indexed ", row, " rows of ", filename,
+                         " with ", index.entries_.size(), " entries");
+  return index;
+}
+
+TimestampIndex TimestampIndex::load(const std::string &index_filename) {
+  std::ifstream in(index_filename, std::ios::binary);
+  if (!in.is_open()) {
+    throw std::runtime_error("Cannot open file: " + index_filename);
+  }
+
+  IndexHeader header;
+  in.read(reinterpret_cast<char *>(&header), sizeof(header));
+  if (!in || header.magic != INDEX_MAGIC) {
+    throw std::runtime_error("Not a timestamp index: " + index_filename);
+  }
+  if (header.version != INDEX_VERSION) {
+    throw std::runtime_error("Unsupported index version: " + index_filename);
+  }
+
+  TimestampIndex index;
+  index.stride_ = header.stride;
+  index.data_size_ = header.data_size;
+  index.entries_.resize(header.count);
+  in.read(reinterpret_cast<char *>(index.entries_.data()),
+          static_cast<std::streamsize>(header.count * sizeof(Entry)));
+  if (!in) {
+    throw std::runtime_error("Index file is truncated: " + index_filename);
+  }
+  return index;
+}
+
+void TimestampIndex::save(const std::string &index_filename) const {
+  std::ofstream out(index_filename, std::ios::binary | std::ios::trunc);
+  if (!out.is_open()) {
+    throw std::runtime_error("Cannot open file for writing: " +
+                             index_filename);
+  }
+
+  IndexHeader header;
+  header.stride = static_cast<std::uint32_t>(stride_);
+  header.count = entries_.size();
+  header.data_size = data_size_;
+  out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  out.write(reinterpret_cast<const char *>(entries_.data()),
+            static_cast<std::streamsize>(entries_.size() * sizeof(Entry)));
+  if (!out) {
+    throw std::runtime_error("Failed to write file: " + index_filename);
+  }
+}
+
+bool TimestampIndex::matches(const std::string &filename) const {
+  std::error_code ec;
+  const auto size = std::filesystem::file_size(filename, ec);
+  return !ec && size == data_size_;
+}
+
+std::uint64_t
+TimestampIndex::offset_before(long long timestamp) const noexcept {
+  // Rows equal to `timestamp` may precede the first entry that reaches it,
+  // so scanning starts from the last entry strictly before it.
+  auto it = std::lower_bound(
+      entries_.begin(), entries_.end(), timestamp,
+      [](const Entry &entry, long long ts) { return entry.timestamp < ts; });
+  if (it != entries_.begin()) {
+    --it;
+  }
+  return it == entries_.end() ? data_size_ : it->offset;
+}
+} // namespace data_loading
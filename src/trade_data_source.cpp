@@ -0,0 +1,69 @@
+#include "data_loader/trade_data_source.hpp"
+#include <algorithm>
+
+namespace data_loading {
+InMemoryTradeSource::InMemoryTradeSource(
+    std::vector<raw_data::TradeData> trades)
+    : data_(std::make_shared<const std::vector<raw_data::TradeData>>(
+          std::move(trades))) {}
+
+InMemoryTradeSource::InMemoryTradeSource(
+    std::shared_ptr<const std::vector<raw_data::TradeData>> trades)
+    : data_(std::move(trades)) {}
+
+const raw_data::TradeData *InMemoryTradeSource::next() {
+  if (data_ == nullptr || cursor_ >= data_->size()) {
+    return nullptr;
+  }
+  return &(*data_)[cursor_++];
+}
+
+bool InMemoryTradeSource::seek(long long timestamp) {
+  if (data_ == nullptr) {
+    return false;
+  }
+  const auto it = std::lower_bound(
+      data_->begin(), data_->end(), timestamp,
+      [](const raw_data::TradeData &trade, long long ts) {
+        return trade.local_timestamp < ts;
+      });
+  cursor_ = static_cast<std::size_t>(it - data_->begin());
+  return true;
+}
+
+CSVTradeSource::CSVTradeSource(const std::string &filename,
+                               std::size_t buffer_size,
+                               const common_types::InstrumentScale &scale)
+    : cursor_(filename, buffer_size), scale_(scale) {}
+
+const raw_data::TradeData *CSVTradeSource::next() {
+  return cursor_.next(current_, parser()) ? &current_ : nullptr;
+}
+
+bool CSVTradeSource::seek(long long timestamp) {
+  return cursor_.seek(timestamp, current_, parser());
+}
+
+BinaryTradeSource::BinaryTradeSource(
+    std::shared_ptr<const BinaryTradesFile> trades_file)
+    : file_(std::move(trades_file)) {}
+
+const raw_data::TradeData *BinaryTradeSource::next() {
+  if (file_ == nullptr || cursor_ >= file_->size()) {
+    return nullptr;
+  }
+  current_ = file_->trade(cursor_++);
+  return &current_;
+}
+
+bool BinaryTradeSource::seek(long long timestamp) {
+  if (file_ == nullptr) {
+    return false;
+  }
+  const std::int64_t *begin = file_->timestamps();
+  const std::int64_t *end = begin + file_->size();
+  cursor_ = static_cast<std::size_t>(std::lower_bound(begin, end, timestamp) -
+                                     begin);
+  return true;
+}
+} // namespace data_loading
@@ -0,0 +1,83 @@
+// Regression tests of repeated backtest runs over the same sources.
+
+#include "execution/backtesing_engine.hpp"
+#include "execution/multi_strategy_engine.hpp"
+#include <cstdio>
+#include <vector>
+
+namespace {
+int failures = 0;
+
+#define CHECK(condition)                                                       \
+  do {                                                                         \
+    if (!(condition)) {                                                        \
+      std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__,    \
+                   #condition);                                                \
+      ++failures;                                                              \
+    }                                                                          \
+  } while (false)
+
+/// Counts the ticks it is called on.
+struct CountingStrategy : vault::StrategyBase {
+  int ticks{0};
+
+  std::optional<common_types::Order> on_tick() override {
+    ++ticks;
+    return std::nullopt;
+  }
+};
+
+/// Two-sided snapshots at timestamps 1..count.
+std::vector<raw_data::LOBData> snapshots(int count) {
+  std::vector<raw_data::LOBData> data(count);
+  for (int i = 0; i < count; ++i) {
+    data[i].local_timestamp = i + 1;
+    data[i].asks.push_back({101, 1});
+    data[i].bids.push_back({100, 1});
+  }
+  return data;
+}
+
+/// A second run replays the data from the start.
+void backtest_runs_again() {
+  auto portfolio = vault::Portfolio::create_portfolio();
+  execution::BacktestEngine engine;
+  engine.link_portfolio(portfolio);
+  engine.add_data(snapshots(3));
+  auto strategy = std::make_unique<CountingStrategy>();
+  CountingStrategy *counter = strategy.get();
+  engine.set_strategy(std::move(strategy));
+
+  CHECK(engine.run());
+  CHECK(counter->ticks == 3);
+  CHECK(engine.run());
+  CHECK(counter->ticks == 6);
+  CHECK(engine.run(2, 3));
+  CHECK(counter->ticks == 7);
+}
+
+/// Same for the multi-strategy engine.
+void multi_strategy_runs_again() {
+  execution::MultiStrategyEngine engine;
+  auto strategy = std::make_unique<CountingStrategy>();
+  CountingStrategy *counter = strategy.get();
+  engine.add_strategy(std::move(strategy),
+                      vault::Portfolio::create_portfolio());
+  engine.add_data(snapshots(3));
+
+  CHECK(engine.run());
+  CHECK(counter->ticks == 3);
+  CHECK(engine.run());
+  CHECK(counter->ticks == 6);
+}
+} // namespace
+
+int main() {
+  backtest_runs_again();
+  multi_strategy_runs_again();
+  if (failures != 0) {
+    std::fprintf(stderr, "%d check(s) failed\n", failures);
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,227 @@
+// Regression tests of resting LimitGtc orders against crossing liquidity.
+
+#include "execution/market_engine.hpp"
+#include <cstdio>
+#include <initializer_list>
+#include <unordered_map>
+#include <utility>
+
+namespace {
+int failures = 0;
+
+#define CHECK(condition)                                                       \
+  do {                                                                         \
+    if (!(condition)) {                                                        \
+      std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__,    \
+                   #condition);                                                \
+      ++failures;                                                              \
+    }                                                                          \
+  } while (false)
+
+using Levels =
+    std::initializer_list<std::pair<common_types::Price, common_types::Amount>>;
+
+/// Builds a snapshot from (price, amount) levels, best first.
+raw_data::LOBData book(long long timestamp, Levels asks, Levels bids) {
+  raw_data::LOBData data{};
+  data.local_timestamp = timestamp;
+  for (const auto &[price, amount] : asks) {
+    data.asks.push_back({price, amount});
+  }
+  for (const auto &[price, amount] : bids) {
+    data.bids.push_back({price, amount});
+  }
+  return data;
+}
+
+common_types::Order gtc_buy(common_types::Price price,
+                            common_types::Amount amount, std::uint64_t id) {
+  return {common_types::Side::Buy, execution::orders::OrderTypes::LimitGtc,
+          price, amount, id};
+}
+
+/// Sums the filled amount of every order and keeps the last rejection.
+struct Recorder : execution::ExecutionListener {
+  std::unordered_map<std::uint64_t, common_types::Amount> filled;
+  int rejects{0};
+  common_types::RejectReason last_reason{};
+
+  void on_fill(const common_types::Order &order,
+               std::span<const common_types::ExecutionFill> fills) override {
+    for (const auto &fill : fills) {
+      filled[order.id] += fill.amount;
+    }
+  }
+
+  void on_order_rejected(const common_types::Order &,
+                         common_types::RejectReason reason) override {
+    ++rejects;
+    last_reason = reason;
+  }
+};
+
+/// One engine stepped like a strategy lane: resting orders, then new ones.
+struct Harness {
+  execution::MarketEngine engine;
+  vault::Portfolio::SPtr portfolio{vault::Portfolio::create_portfolio()};
+  Recorder recorder;
+  raw_data::LOBData data{};
+  execution::BookFeatures features;
+
+  Harness() {
+    portfolio->set_scale({0, 0});
+    portfolio->set_cash(1e9);
+    engine.set_listener(&recorder);
+  }
+
+  /// Processes a snapshot, submitting `orders` on it.
+  void snapshot(const raw_data::LOBData &next,
+                std::initializer_list<common_types::Order> orders = {}) {
+    data = next;
+    features.reset(data);
+    engine.advance_to(data.local_timestamp);
+    engine.update_resting(features, portfolio);
+    for (const auto &order : orders) {
+      engine.add_order(order, data.local_timestamp);
+    }
+    engine.tick(features, portfolio);
+  }
+
+  /// Processes a market trade against the latest snapshot.
+  void trade(common_types::Side side, common_types::Price price,
+             common_types::Amount amount) {
+    data.local_timestamp += 1;
+    engine.advance_to(data.local_timestamp);
+    engine.on_market_trade({data.local_timestamp, side, price, amount},
+                           portfolio);
+  }
+
+  common_types::Amount filled(std::uint64_t id) { return recorder.filled[id]; }
+
+  bool resting(std::uint64_t id) const {
+    return engine.resting_orders().contains(id);
+  }
+};
+
+/// The crossed part taken on arrival is not filled again by snapshots that
+/// still display it, only by depth beyond it.
+void crossed_on_arrival_fills_once() {
+  Harness h;
+  const auto crossed = book(1, {{100, 3}, {101, 50}}, {{99, 1}});
+  h.snapshot(crossed, {gtc_buy(100, 10, 1)});
+  CHECK(h.filled(1) == 3);
+  CHECK(h.resting(1));
+
+  for (long long ts = 2; ts < 5; ++ts) {
+    h.snapshot(book(ts, {{100, 3}, {101, 50}}, {{99, 1}}));
+  }
+  CHECK(h.filled(1) == 3);
+
+  // Two more displayed at the price are new liquidity.
+  h.snapshot(book(5, {{100, 5}, {101, 50}}, {{99, 1}}));
+  CHECK(h.filled(1) == 5);
+  h.snapshot(book(6, {{100, 5}, {101, 50}}, {{99, 1}}));
+  CHECK(h.filled(1) == 5);
+}
+
+/// Same for an order placed on a market trade against the latest snapshot.
+void crossed_on_trade_arrival_fills_once() {
+  Harness h;
+  h.snapshot(book(1, {{100, 3}, {101, 50}}, {{99, 1}}));
+  h.engine.submit_and_tick(gtc_buy(100, 10, 1), 2, h.features, h.portfolio);
+  CHECK(h.filled(1) == 3);
+
+  h.snapshot(book(3, {{100, 3}, {101, 50}}, {{99, 1}}));
+  h.snapshot(book(4, {{100, 3}, {101, 50}}, {{99, 1}}));
+  CHECK(h.filled(1) == 3);
+  CHECK(h.resting(1));
+}
+
+/// An order that queued behind the displayed bids and is crossed later
+/// fills with the crossing depth once.
+void queued_order_crossed_once() {
+  Harness h;
+  h.snapshot(book(1, {{101, 2}}, {{100, 4}}), {gtc_buy(100, 10, 1)});
+  common_types::Amount ahead{};
+  CHECK(h.engine.resting_orders().queue_ahead(1, ahead) && ahead == 4);
+
+  // Gets past the queue ahead and fills with the rest.
+  h.trade(common_types::Side::Sell, 100, 5);
+  CHECK(h.filled(1) == 1);
+
+  h.snapshot(book(10, {{100, 3}, {101, 50}}, {{99, 1}}));
+  CHECK(h.filled(1) == 4);
+  h.snapshot(book(11, {{100, 3}, {101, 50}}, {{99, 1}}));
+  h.snapshot(book(12, {{100, 3}, {101, 50}}, {{99, 1}}));
+  CHECK(h.filled(1) == 4);
+}
+
+/// Trades through the price still fill the rest, and crossed liquidity that
+/// left the book and returns is new.
+void trade_through_after_crossing() {
+  Harness h;
+  h.snapshot(book(1, {{100, 3}, {101, 50}}, {{99, 1}}),
+             {gtc_buy(100, 10, 1), gtc_buy(100, 10, 2)});
+  CHECK(h.filled(1) == 3);
+  // The first order already took the displayed 3; the second rests whole.
+  CHECK(h.filled(2) == 0);
+  CHECK(h.resting(2));
+
+  h.snapshot(book(2, {{101, 50}}, {{99, 1}}));
+  h.snapshot(book(3, {{100, 3}, {101, 50}}, {{99, 1}}));
+  CHECK(h.filled(1) == 6);
+  CHECK(h.filled(2) == 0);
+
+  h.trade(common_types::Side::Sell, 99, 1);
+  CHECK(h.filled(1) == 10);
+  CHECK(h.filled(2) == 10);
+  CHECK(!h.resting(1) && !h.resting(2));
+
+  h.snapshot(book(10, {{100, 3}, {101, 50}}, {{99, 1}}));
+  CHECK(h.filled(1) == 10);
+}
+
+/// A trade removes the orders it filled and leaves the levels it did not
+/// reach untouched.
+void trade_compacts_reached_levels() {
+  Harness h;
+  h.snapshot(book(1, {{102, 5}}, {{101, 2}, {100, 4}}),
+             {gtc_buy(101, 2, 1), gtc_buy(100, 3, 2)});
+  h.trade(common_types::Side::Sell, 101, 4);
+  CHECK(h.filled(1) == 2);
+  CHECK(!h.resting(1));
+  common_types::Amount ahead{};
+  CHECK(h.engine.resting_orders().queue_ahead(2, ahead) && ahead == 4);
+  CHECK(h.engine.resting_orders().size() == 1);
+
+  h.trade(common_types::Side::Sell, 99, 1);
+  CHECK(h.filled(2) == 3);
+  CHECK(h.engine.resting_orders().empty());
+}
+
+/// A resting id submitted again is rejected instead of throwing mid-tick.
+void duplicate_resting_id_rejected() {
+  Harness h;
+  h.snapshot(book(1, {{101, 2}}, {{100, 4}}), {gtc_buy(100, 10, 7)});
+  h.snapshot(book(2, {{101, 2}}, {{100, 4}}),
+             {gtc_buy(99, 5, 7), gtc_buy(99, 5, 8)});
+  CHECK(h.recorder.rejects == 1);
+  CHECK(h.recorder.last_reason == common_types::RejectReason::DuplicateId);
+  CHECK(h.engine.resting_orders().size() == 2);
+  CHECK(h.resting(8));
+}
+} // namespace
+
+int main() {
+  crossed_on_arrival_fills_once();
+  crossed_on_trade_arrival_fills_once();
+  queued_order_crossed_once();
+  trade_through_after_crossing();
+  trade_compacts_reached_levels();
+  duplicate_resting_id_rejected();
+  if (failures != 0) {
+    std::fprintf(stderr, "%d check(s) failed\n", failures);
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,26 @@
+#include "data_loader/args_parses.hpp"
+#include "data_loader/timestamp_index.hpp"
+#include <iostream>
+
+namespace {
+/// Builds the index of a CSV file and saves it next to the file.
+void write_index(const std::string &csv_path) {
+  const auto index = data_loading::TimestampIndex::build(csv_path);
+  const auto index_path = data_loading::TimestampIndex::path_for(csv_path);
+  index.save(index_path);
+
+  std::cout << csv_path << " -> " << index_path << " (" << index.size()
+            << " entries, every " << index.stride() << " rows)" << std::endl;
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+  ProgramArgs args = parse_arguments(argc, argv);
+
+  write_index(args.lob);
+  if (!args.trades.empty()) {
+    write_index(args.trades);
+  }
+
+  return 0;
+}
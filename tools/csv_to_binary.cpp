@@ -0,0 +1,40 @@
+#include "data_loader/args_parses.hpp"
+#include "data_loader/binary_format.hpp"
+#include "data_loader/csv_parser.hpp"
+#include "data_loader/mmap_csv_parser.hpp"
+#include <filesystem>
+#include <iostream>
+
+namespace {
+/// Output path next to the input, with the extension replaced by ".bin".
+std::string binary_path(const std::string &csv_path) {
+  return std::filesystem::path(csv_path).replace_extension(".bin").string();
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+  ProgramArgs args = parse_arguments(argc, argv);
+
+  auto csv_parser =
+      args.parser == "mmap"
+          ? data_loading::create_parser<data_loading::MMapCSVParser>(
+                25, args.threads)
+          : data_loading::create_parser<data_loading::CSVParser>();
+  csv_parser->set_scale(args.scale);
+
+  auto [lob_data, trades_data] = csv_parser->load(args.lob, args.trades);
+
+  const auto lob_out = binary_path(args.lob);
+  data_loading::binary::write_lob(lob_out, lob_data, args.scale);
+  std::cout << args.lob << " -> " << lob_out << " (" << lob_data.size()
+            << " snapshots)" << std::endl;
+
+  if (!args.trades.empty()) {
+    const auto trades_out = binary_path(args.trades);
+    data_loading::binary::write_trades(trades_out, trades_data, args.scale);
+    std::cout << args.trades << " -> " << trades_out << " ("
+              << trades_data.size() << " trades)" << std::endl;
+  }
+
+  return 0;
+}